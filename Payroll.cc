@@ -7,8 +7,112 @@
 #include <sstream>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <string_view>
+#include <random>
+#include <chrono>
+#include <utility>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <csignal>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 using namespace std;
 
+// Steady clock used for all timing in benchmark mode
+using Clock = chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// ================= MEMORY ACCOUNTING =================
+
+// Containers whose allocations are counted, one counter each
+enum MemSubsystem {
+    MEM_ROSTER,     // Company's employee pointer vector
+    MEM_ID_INDEX,   // Company's ID -> position index
+    MEM_REVIEWS,    // every employee's performanceHistory
+    MEM_QUERY,      // temporaries of the report queries
+    MEM_SUBSYSTEMS
+};
+
+static const char* const memSubsystemNames[MEM_SUBSYSTEMS] = {
+    "roster", "id index", "reviews", "query temporaries"
+};
+
+// Relaxed atomics: the query server allocates from several threads
+struct AllocCounter {
+    atomic<size_t> allocations{0};
+    atomic<size_t> bytes{0};    // total ever allocated
+    atomic<size_t> live{0};
+    atomic<size_t> peak{0};     // highest `live` since the last resetPeak()
+
+    void onAllocate(size_t n) {
+        allocations.fetch_add(1, memory_order_relaxed);
+        bytes.fetch_add(n, memory_order_relaxed);
+        size_t now = live.fetch_add(n, memory_order_relaxed) + n;
+        size_t seen = peak.load(memory_order_relaxed);
+        while (now > seen && !peak.compare_exchange_weak(seen, now, memory_order_relaxed)) {}
+    }
+
+    void onDeallocate(size_t n) {
+        live.fetch_sub(n, memory_order_relaxed);
+    }
+
+    void resetPeak() {
+        peak.store(live.load(memory_order_relaxed), memory_order_relaxed);
+    }
+};
+
+static AllocCounter memCounters[MEM_SUBSYSTEMS];
+
+// std::allocator that reports every allocation to its subsystem's counter
+template <class T, MemSubsystem S>
+struct CountingAllocator {
+    using value_type = T;
+    template <class U> struct rebind { using other = CountingAllocator<U, S>; };
+
+    CountingAllocator() = default;
+    template <class U> CountingAllocator(const CountingAllocator<U, S>&) {}
+
+    T* allocate(size_t n) {
+        memCounters[S].onAllocate(n * sizeof(T));
+        return allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        memCounters[S].onDeallocate(n * sizeof(T));
+        allocator<T>().deallocate(p, n);
+    }
+
+    template <class U> bool operator==(const CountingAllocator<U, S>&) const { return true; }
+    template <class U> bool operator!=(const CountingAllocator<U, S>&) const { return false; }
+};
+
+template <class T, MemSubsystem S>
+using CountedVector = vector<T, CountingAllocator<T, S>>;
+
+// Heap block behind a string; short strings live inline (SSO)
+static size_t stringHeap(const string& str) {
+    return str.capacity() > string().capacity() ? str.capacity() + 1 : 0;
+}
+
 // ================= ABSTRACT BASE CLASSES =================
 
 // Root abstract class for all entities
@@ -38,12 +142,8 @@ public:
 
 // Abstract class for taxable entities
 class Taxable {
-protected:
-    const float TAX_RATE = 0.10; // 10% tax
 public:
-    virtual float calculateTax(float amount) {
-        return amount * TAX_RATE;
-    }
+    virtual float calculateTax(float amount) = 0;
     virtual ~Taxable() {}
 };
 
@@ -65,6 +165,345 @@ public:
     }
 
     int getRating() const { return rating; }
+
+    size_t heapUsage() const {
+        return stringHeap(review) + stringHeap(date) + stringHeap(reviewedBy);
+    }
+};
+
+// ================= PAY INPUTS =================
+
+// Flattened pay inputs of one employee. For every employee type
+// calculatePay() == fixedPay + hourlyRate * hours
+//                   + contractAmount * (contractCompleted ? 1 : 0.5)
+struct PayComponents {
+    float fixedPay;        // salary + standing bonuses (full-time)
+    float hourlyRate;      // part-time and interns
+    float contractAmount;  // contract employees
+    float hours;           // hours logged this period
+    bool contractCompleted;
+};
+
+// ================= TAX POLICIES =================
+
+// Employee type tags used for per-type rules in batch code
+enum EmployeeKind {
+    KIND_FULLTIME,
+    KIND_MANAGER,
+    KIND_DEVELOPER,
+    KIND_PARTTIME,
+    KIND_INTERN,
+    KIND_CONTRACT,
+    KIND_COUNT
+};
+
+// A bracket taxes the part of taxable income above `from` at `rate`
+struct TaxBracket {
+    float from;
+    float rate;
+};
+
+// Today's behaviour: 10% of gross for everyone
+struct FlatTaxPolicy {
+    static constexpr const char* NAME = "Flat 10%";
+    static constexpr int BRACKETS = 1;
+    static constexpr TaxBracket brackets[BRACKETS] = {{0, 0.10f}};
+    static constexpr bool HAS_DEDUCTIONS = false;
+    static constexpr float deductions[KIND_COUNT] = {0, 0, 0, 0, 0, 0};
+};
+
+// Monthly progressive brackets with a standard deduction per employee type
+struct ProgressiveTaxPolicy {
+    static constexpr const char* NAME = "Progressive";
+    static constexpr int BRACKETS = 4;
+    static constexpr TaxBracket brackets[BRACKETS] = {
+        {0, 0.05f}, {3000, 0.10f}, {8000, 0.20f}, {15000, 0.30f}
+    };
+    static constexpr bool HAS_DEDUCTIONS = true;
+    static constexpr float deductions[KIND_COUNT] = {
+        500,   // Full-Time
+        500,   // Manager
+        500,   // Developer
+        250,   // Part-Time
+        1000,  // Intern
+        0      // Contract
+    };
+};
+
+// Rate step added by bracket i on top of the brackets below it
+template <class Policy>
+constexpr float marginalRate(int i) {
+    return Policy::brackets[i].rate - (i > 0 ? Policy::brackets[i - 1].rate : 0.0f);
+}
+
+// max(x, 0) without a comparison; compilers turn max() into a branch
+inline float positivePart(float x) {
+    return (x + fabs(x)) * 0.5f;
+}
+
+// Brackets are unrolled at compile time and summed as marginal rate
+// steps, so the per-employee tax has no branches or loops.
+template <class Policy, size_t... I>
+inline float bracketTax(float taxable, index_sequence<I...>) {
+    return (0.0f + ... + (marginalRate<Policy>(I)
+                          * positivePart(taxable - Policy::brackets[I].from)));
+}
+
+// A single bracket from zero with no deductions is a flat rate; it
+// compiles to the same multiply as the old fixed TAX_RATE
+template <class Policy>
+constexpr bool isFlatRate() {
+    return Policy::BRACKETS == 1 && Policy::brackets[0].from == 0 && !Policy::HAS_DEDUCTIONS;
+}
+
+template <class Policy>
+inline float policyTax(float gross, int kind) {
+    if constexpr (isFlatRate<Policy>()) {
+        return gross * Policy::brackets[0].rate;
+    }
+    float taxable = gross;
+    if constexpr (Policy::HAS_DEDUCTIONS) {
+        taxable = positivePart(gross - Policy::deductions[kind]);
+    }
+    return bracketTax<Policy>(taxable, make_index_sequence<Policy::BRACKETS>());
+}
+
+// -O2 only vectorizes loops that need no scalar remainder, so the batch
+// runs in fixed blocks of 8 (which it does vectorize) plus a short tail.
+// The columns never overlap.
+template <class Policy>
+void policyTaxBatch(const float* __restrict gross, const unsigned char* __restrict kind,
+                    float* __restrict tax, size_t n) {
+    const size_t BLOCK = 8;
+    size_t i = 0;
+    for (; i + BLOCK <= n; i += BLOCK) {
+        for (size_t j = 0; j < BLOCK; j++) {
+            tax[i + j] = policyTax<Policy>(gross[i + j], kind[i + j]);
+        }
+    }
+    for (; i < n; i++) {
+        tax[i] = policyTax<Policy>(gross[i], kind[i]);
+    }
+}
+
+enum TaxPolicyId {
+    TAX_FLAT,
+    TAX_PROGRESSIVE
+};
+
+static TaxPolicyId activeTaxPolicy = TAX_FLAT;
+
+// Runtime dispatch happens once per call (or once per batch), never per bracket
+float computeTax(float gross, int kind) {
+    switch (activeTaxPolicy) {
+        case TAX_PROGRESSIVE: return policyTax<ProgressiveTaxPolicy>(gross, kind);
+        default: return policyTax<FlatTaxPolicy>(gross, kind);
+    }
+}
+
+void computeTaxBatch(const float* gross, const unsigned char* kind, float* tax, size_t n) {
+    switch (activeTaxPolicy) {
+        case TAX_PROGRESSIVE: policyTaxBatch<ProgressiveTaxPolicy>(gross, kind, tax, n); break;
+        default: policyTaxBatch<FlatTaxPolicy>(gross, kind, tax, n);
+    }
+}
+
+const char* taxPolicyName() {
+    switch (activeTaxPolicy) {
+        case TAX_PROGRESSIVE: return ProgressiveTaxPolicy::NAME;
+        default: return FlatTaxPolicy::NAME;
+    }
+}
+
+// ================= HOT RECORDS =================
+
+// Everything the payroll loops read for one employee, packed into half a
+// cache line. A company keeps these in roster order in one column, so
+// hot[e] belongs to employees[e] and the roster position is the key; the
+// Employee object (the cold record) points at its entry.
+struct HotRecord {
+    float fixedPay;        // see PayComponents
+    float hourlyRate;
+    float contractAmount;
+    float hours;
+    int32_t departmentCode;
+    int32_t leaveBalance;
+    int32_t leavesTaken;
+    uint8_t kind;          // EmployeeKind
+    bool contractCompleted;
+
+    float pay() const {
+        return fixedPay + hourlyRate * hours
+               + contractAmount * (contractCompleted ? 1.0f : 0.5f);
+    }
+};
+
+static_assert(sizeof(HotRecord) == 32, "two hot records per cache line");
+
+// Hot records in fixed blocks of contiguous records. Blocks never move,
+// so employees can keep pointers into the column while it grows, and a
+// pass over the column streams through memory block by block.
+class HotColumn {
+private:
+    static const size_t BLOCK_SHIFT = 12;
+    static const size_t BLOCK_SIZE = size_t(1) << BLOCK_SHIFT; // 128 KB of records
+    vector<unique_ptr<HotRecord[]>> blocks;
+    size_t count = 0;
+
+public:
+    class const_iterator {
+    private:
+        const HotColumn* column;
+        size_t index;
+
+    public:
+        const_iterator(const HotColumn* c, size_t i) : column(c), index(i) {}
+        const HotRecord& operator*() const { return (*column)[index]; }
+        const_iterator& operator++() {
+            index++;
+            return *this;
+        }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    };
+
+    HotRecord& operator[](size_t i) { return blocks[i >> BLOCK_SHIFT][i & (BLOCK_SIZE - 1)]; }
+    const HotRecord& operator[](size_t i) const { return blocks[i >> BLOCK_SHIFT][i & (BLOCK_SIZE - 1)]; }
+
+    HotRecord& emplace_back() {
+        if ((count >> BLOCK_SHIFT) == blocks.size()) {
+            blocks.emplace_back(new HotRecord[BLOCK_SIZE]());
+        }
+        return (*this)[count++];
+    }
+
+    // Shrinks only; emptied blocks are released
+    void resize(size_t n) {
+        count = min(count, n);
+        blocks.resize((count + BLOCK_SIZE - 1) >> BLOCK_SHIFT);
+    }
+
+    size_t size() const { return count; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
+
+// ================= SYMBOL TABLES =================
+
+// Interns repeated strings as small dense integer codes. Hot paths group
+// and compare by code; names are decoded only for display.
+class SymbolTable {
+private:
+    vector<string> names;
+    unordered_map<string, int> codes;
+
+public:
+    int intern(const string& name) {
+        auto it = codes.find(name);
+        if (it != codes.end()) return it->second;
+        int code = names.size();
+        codes.emplace(name, code);
+        names.push_back(name);
+        return code;
+    }
+
+    // -1 if the name was never interned
+    int find(const string& name) const {
+        auto it = codes.find(name);
+        return it == codes.end() ? -1 : it->second;
+    }
+
+    const string& name(int code) const { return names[code]; }
+    int size() const { return names.size(); }
+
+    // All codes, ordered by name for display
+    vector<int> sortedCodes() const {
+        vector<int> order(names.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = i;
+        sort(order.begin(), order.end(),
+             [this](int a, int b) { return names[a] < names[b]; });
+        return order;
+    }
+
+    size_t memoryUsage() const {
+        size_t bytes = names.capacity() * sizeof(string)
+                       + codes.bucket_count() * sizeof(void*)
+                       + codes.size() * (sizeof(pair<const string, int>) + sizeof(void*));
+        for (const auto& n : names) bytes += stringHeap(n);
+        for (const auto& entry : codes) bytes += stringHeap(entry.first);
+        return bytes;
+    }
+};
+
+static SymbolTable departmentSymbols;
+static SymbolTable languageSymbols;
+static SymbolTable universitySymbols;
+static SymbolTable mentorSymbols;
+
+const string& kindName(int kind) {
+    static const string names[KIND_COUNT] = {
+        "Full-Time Employee", "Manager", "Developer",
+        "Part-Time Employee", "Intern", "Contract Employee"
+    };
+    return names[kind];
+}
+
+// ================= COLD FIELD STORAGE =================
+
+// Owned text of the cold fields of lazily loaded employees: each record's
+// span from the address to its last cold field, copied out of the roster
+// text while parsing, so neither the hot fields nor the roster file stay
+// resident. Being a copy, it is unaffected when the nightly workflow
+// rewrites the roster file in place.
+class ColdArena {
+private:
+    string text;
+
+public:
+    // Spans are stored as 32-bit offsets
+    static const size_t MAX_SIZE = numeric_limits<uint32_t>::max();
+
+    ColdArena() {}
+    ColdArena(const ColdArena&) = delete;
+    ColdArena& operator=(const ColdArena&) = delete;
+
+    // Copies a span in and returns its offset
+    uint32_t append(const char* span, size_t length) {
+        uint32_t offset = text.size();
+        text.append(span, length);
+        return offset;
+    }
+
+    void shrinkToFit() { text.shrink_to_fit(); }
+    size_t size() const { return text.size(); }
+
+    // The index-th '|' separated field of the span at [offset, offset + len)
+    string field(uint32_t offset, uint32_t len, int index) const {
+        string_view record(text.data() + offset, len);
+        size_t start = 0;
+        for (int i = 0; i < index; i++) {
+            start = record.find('|', start);
+            if (start == string_view::npos) return "";
+            start++;
+        }
+        size_t end = record.find('|', start);
+        return string(record.substr(start, end == string_view::npos ? string_view::npos : end - start));
+    }
+};
+
+// Field positions counted in '|' separated parts from the address, the
+// first cold field; counting from the record start would misplace them
+// when an ID contains '|'
+enum ColdField {
+    FIELD_ADDRESS = 0,
+    FIELD_JOIN_DATE = 2,
+    FIELD_CONTRACT_END = 3
+};
+
+// Rarely used text fields, allocated only for eagerly loaded employees
+struct ColdFields {
+    string address;
+    string joinDate;
+    string contractEndDate;
 };
 
 // ================= PERSON HIERARCHY =================
@@ -73,11 +512,39 @@ class Person : public Entity, public Identifiable {
 protected:
     string name;
     int age;
-    string address;
+
+    // Cold fields live either in `cold` (eager load) or as one span in
+    // a cold arena (lazy load)
+    unique_ptr<ColdFields> cold;
+    const ColdArena* coldArena;
+    uint32_t coldOffset;
+    uint32_t coldLength;
+
+    ColdFields& coldFields() {
+        if (!cold) cold.reset(new ColdFields());
+        return *cold;
+    }
+
+    string coldField(ColdField field, string ColdFields::*member) {
+        if (coldArena) return coldArena->field(coldOffset, coldLength, field);
+        return cold ? (*cold).*member : "";
+    }
 
 public:
     Person(string id, string n, int a, string addr)
-        : Identifiable(id), name(n), age(a), address(addr) {}
+        : Identifiable(id), name(n), age(a),
+          coldArena(nullptr), coldOffset(0), coldLength(0) {
+        if (!addr.empty()) coldFields().address = addr;
+    }
+
+    void setColdRecord(const ColdArena* arena, uint32_t offset, uint32_t length) {
+        coldArena = arena;
+        coldOffset = offset;
+        coldLength = length;
+    }
+
+    string getAddress() { return coldField(FIELD_ADDRESS, &ColdFields::address); }
+    int getAge() { return age; }
 
     string getEntityType() override {
         return "Person";
@@ -96,37 +563,68 @@ public:
 // Abstract Employee class
 class Employee : public Person, public Payable, public Taxable {
 protected:
-    string department;
-    string joinDate;
+    // Pay inputs, type tag, department and leave counters live in the
+    // hot record: owned here until the employee joins a company, then
+    // in the company's hot column
+    HotRecord* hot;
+    unique_ptr<HotRecord> detachedHot;
+
     int experienceYears;
-    vector<PerformanceRecord> performanceHistory;
-    int leaveBalance;
-    int leavesTaken;
+    CountedVector<PerformanceRecord, MEM_REVIEWS> performanceHistory;
+    size_t recordHash; // hash of the roster line this employee was loaded from
 
 public:
     Employee(string id, string n, int a, string addr,
-             string dept, string date, int exp)
-        : Person(id, n, a, addr), department(dept),
-          joinDate(date), experienceYears(exp),
-          leaveBalance(20), leavesTaken(0) {}
+             string dept, string date, int exp, EmployeeKind kind)
+        : Person(id, n, a, addr), hot(new HotRecord()), detachedHot(hot),
+          experienceYears(exp), recordHash(0) {
+        hot->departmentCode = departmentSymbols.intern(dept);
+        hot->leaveBalance = 20;
+        hot->kind = kind;
+        if (!date.empty()) coldFields().joinDate = date;
+    }
+
+    // Copies the hot record into `slot` and uses that from then on
+    void moveHotRecord(HotRecord* slot) {
+        *slot = *hot;
+        hot = slot;
+        detachedHot.reset();
+    }
+
+    const HotRecord& getHotRecord() { return *hot; }
 
     string getEntityType() override {
         return "Employee";
     }
 
-    virtual string getEmployeeType() = 0;
     virtual float getBaseSalary() = 0;
 
+    float calculatePay() override {
+        return hot->pay();
+    }
+
+    PayComponents getPayComponents() {
+        return {hot->fixedPay, hot->hourlyRate, hot->contractAmount, hot->hours, hot->contractCompleted};
+    }
+
+    EmployeeKind getKind() { return (EmployeeKind)hot->kind; }
+
+    const string& getEmployeeType() { return kindName(getKind()); }
+
+    float calculateTax(float amount) override {
+        return computeTax(amount, getKind());
+    }
+
     void display() override {
         cout << "\n--- " << getEmployeeType() << " ---\n";
         cout << "ID         : " << id << endl;
         cout << "Name       : " << name << endl;
         cout << "Age        : " << age << endl;
-        cout << "Department : " << department << endl;
+        cout << "Department : " << getDepartment() << endl;
         cout << "Experience : " << experienceYears << " years\n";
-        cout << "Join Date  : " << joinDate << endl;
-        cout << "Leaves     : " << leavesTaken << " taken, "
-             << leaveBalance << " remaining\n";
+        cout << "Join Date  : " << getJoinDate() << endl;
+        cout << "Leaves     : " << hot->leavesTaken << " taken, "
+             << hot->leaveBalance << " remaining\n";
     }
 
     void generatePaySlip() override {
@@ -139,11 +637,11 @@ public:
         cout << "========================================\n";
         cout << "Employee ID    : " << id << endl;
         cout << "Type           : " << getEmployeeType() << endl;
-        cout << "Department     : " << department << endl;
+        cout << "Department     : " << getDepartment() << endl;
         cout << "----------------------------------------\n";
         cout << fixed << setprecision(2);
         cout << "Gross Salary   : $" << gross << endl;
-        cout << "Tax (10%)      : $" << tax << endl;
+        cout << "Tax            : $" << tax << " (" << taxPolicyName() << ")" << endl;
         cout << "----------------------------------------\n";
         cout << "Net Salary     : $" << net << endl;
         cout << "========================================\n";
@@ -175,17 +673,44 @@ public:
     }
 
     bool applyLeave(int days) {
-        if (days <= leaveBalance) {
-            leaveBalance -= days;
-            leavesTaken += days;
+        if (days > 0 && days <= hot->leaveBalance) {
+            hot->leaveBalance -= days;
+            hot->leavesTaken += days;
             return true;
         }
         return false;
     }
 
-    string getDepartment() { return department; }
+    // Keeps in-memory state (reviews, leave, logged hours) when a
+    // roster record is replaced by a newer version of itself
+    virtual void carryStateFrom(Employee& old) {
+        performanceHistory = move(old.performanceHistory);
+        hot->leaveBalance = old.hot->leaveBalance;
+        hot->leavesTaken = old.hot->leavesTaken;
+    }
+
+    const string& getDepartment() { return departmentSymbols.name(hot->departmentCode); }
+    string getJoinDate() { return coldField(FIELD_JOIN_DATE, &ColdFields::joinDate); }
+    int getDepartmentCode() { return hot->departmentCode; }
     int getExperience() { return experienceYears; }
-    int getLeavesTaken() { return leavesTaken; }
+    int getLeavesTaken() { return hot->leavesTaken; }
+    size_t getRecordHash() { return recordHash; }
+    void setRecordHash(size_t h) { recordHash = h; }
+
+    // Heap bytes owned beyond the object and its hot record. Cold fields
+    // of a lazily loaded employee stay in the roster file and count zero.
+    size_t heapUsage() {
+        size_t bytes = stringHeap(id) + stringHeap(name);
+        if (cold) {
+            bytes += sizeof(ColdFields) + stringHeap(cold->address)
+                     + stringHeap(cold->joinDate) + stringHeap(cold->contractEndDate);
+        }
+        bytes += performanceHistory.capacity() * sizeof(PerformanceRecord);
+        for (const auto& record : performanceHistory) {
+            bytes += record.heapUsage();
+        }
+        return bytes;
+    }
 };
 
 // ================= FULL-TIME EMPLOYEES =================
@@ -195,11 +720,19 @@ protected:
     float monthlySalary;
     float bonus;
 
+    // Salary parts stay in the cold record; their sum is the hot
+    // record's fixedPay and is refreshed whenever one of them changes
+    virtual float getFixedPay() { return monthlySalary + bonus; }
+    void refreshFixedPay() { hot->fixedPay = getFixedPay(); }
+
 public:
     FullTimeEmployee(string id, string n, int a, string addr,
-                     string dept, string date, int exp, float salary)
-        : Employee(id, n, a, addr, dept, date, exp),
-          monthlySalary(salary), bonus(0) {}
+                     string dept, string date, int exp, float salary,
+                     EmployeeKind kind = KIND_FULLTIME)
+        : Employee(id, n, a, addr, dept, date, exp, kind),
+          monthlySalary(salary), bonus(0) {
+        refreshFixedPay();
+    }
 
     float getBaseSalary() override {
         return monthlySalary;
@@ -207,18 +740,25 @@ public:
 
     void setBonus(float b) {
         bonus = b;
+        refreshFixedPay();
     }
 
-    float calculatePay() override {
-        return monthlySalary + bonus;
+    float getBonus() { return bonus; }
+    float getMonthlySalary() { return monthlySalary; }
+
+    void setMonthlySalary(float salary) {
+        monthlySalary = salary;
+        refreshFixedPay();
     }
 
-    string getEmployeeType() override {
-        return "Full-Time Employee";
+    // Silent mutation, shared by the menu and the query server
+    void applyRaise(float percentage) {
+        monthlySalary += monthlySalary * (percentage / 100);
+        refreshFixedPay();
     }
 
     void giveRaise(float percentage) {
-        monthlySalary += monthlySalary * (percentage / 100);
+        applyRaise(percentage);
         cout << name << " received a " << percentage << "% raise!\n";
         cout << "New salary: $" << monthlySalary << endl;
     }
@@ -233,15 +773,13 @@ private:
 public:
     Manager(string id, string n, int a, string addr,
             string dept, string date, int exp, float salary, int team)
-        : FullTimeEmployee(id, n, a, addr, dept, date, exp, salary),
-          teamSize(team), teamBonus(500 * team) {}
-
-    float calculatePay() override {
-        return monthlySalary + bonus + teamBonus;
+        : FullTimeEmployee(id, n, a, addr, dept, date, exp, salary, KIND_MANAGER),
+          teamSize(team), teamBonus(500 * team) {
+        refreshFixedPay();
     }
 
-    string getEmployeeType() override {
-        return "Manager";
+    float getFixedPay() override {
+        return monthlySalary + bonus + teamBonus;
     }
 
     void display() override {
@@ -251,40 +789,55 @@ public:
     }
 
     int getTeamSize() { return teamSize; }
+
+    // Team size (and so the team bonus) follows the real org chart
+    void setTeamSize(int team) {
+        teamSize = team;
+        teamBonus = 500 * team;
+        refreshFixedPay();
+    }
 };
 
 // Developer - inherits from FullTimeEmployee
 class Developer : public FullTimeEmployee {
 private:
-    string programmingLanguage;
+    int languageCode;
     int projectsCompleted;
 
 public:
     Developer(string id, string n, int a, string addr,
               string dept, string date, int exp, float salary, string lang, int projects)
-        : FullTimeEmployee(id, n, a, addr, dept, date, exp, salary),
-          programmingLanguage(lang), projectsCompleted(projects) {
-        bonus = projects * 200; // Bonus per project
+        : FullTimeEmployee(id, n, a, addr, dept, date, exp, salary, KIND_DEVELOPER),
+          languageCode(languageSymbols.intern(lang)), projectsCompleted(projects) {
+        refreshFixedPay();
     }
 
-    void completeProject() {
+    // The project bonus is its own term, so setting `bonus` (a bulk bonus
+    // table) adds to it rather than replacing it
+    float getProjectBonus() { return projectsCompleted * 200; } // Bonus per project
+
+    float getFixedPay() override {
+        return monthlySalary + bonus + getProjectBonus();
+    }
+
+    void recordProject() {
         projectsCompleted++;
-        bonus += 200;
-        cout << name << " completed a project! Total: " << projectsCompleted << "\n";
+        refreshFixedPay();
     }
 
-    string getEmployeeType() override {
-        return "Developer";
+    void completeProject() {
+        recordProject();
+        cout << name << " completed a project! Total: " << projectsCompleted << "\n";
     }
 
     void display() override {
         FullTimeEmployee::display();
-        cout << "Language   : " << programmingLanguage << endl;
+        cout << "Language   : " << getLanguage() << endl;
         cout << "Projects   : " << projectsCompleted << endl;
-        cout << "Project Bonus: $" << (projectsCompleted * 200) << endl;
+        cout << "Project Bonus: $" << getProjectBonus() << endl;
     }
 
-    string getLanguage() { return programmingLanguage; }
+    const string& getLanguage() { return languageSymbols.name(languageCode); }
     int getProjects() { return projectsCompleted; }
 };
 
@@ -292,265 +845,1044 @@ public:
 
 class PartTimeEmployee : public Employee {
 protected:
-    float hourlyRate;
-    int hoursWorked;
+    int loggedHours; // hours added through logHours since loading
 
 public:
     PartTimeEmployee(string id, string n, int a, string addr,
-                     string dept, string date, int exp, float rate, int hours)
-        : Employee(id, n, a, addr, dept, date, exp),
-          hourlyRate(rate), hoursWorked(hours) {}
+                     string dept, string date, int exp, float rate, int hours,
+                     EmployeeKind kind = KIND_PARTTIME)
+        : Employee(id, n, a, addr, dept, date, exp, kind), loggedHours(0) {
+        hot->hourlyRate = rate;
+        hot->hours = hours;
+    }
 
-    void logHours(int hours) {
-        hoursWorked += hours;
-        cout << name << " logged " << hours << " hours. Total: " << hoursWorked << "\n";
+    void addHours(int hours) {
+        hot->hours += hours;
+        loggedHours += hours;
     }
 
-    float getBaseSalary() override {
-        return hourlyRate * 160;
+    void logHours(int hours) {
+        addHours(hours);
+        cout << name << " logged " << hours << " hours. Total: " << getHours() << "\n";
     }
 
-    float calculatePay() override {
-        return hourlyRate * hoursWorked;
+    void carryStateFrom(Employee& old) override {
+        Employee::carryStateFrom(old);
+        PartTimeEmployee* pte = dynamic_cast<PartTimeEmployee*>(&old);
+        if (pte) {
+            hot->hours += pte->loggedHours;
+            loggedHours = pte->loggedHours;
+        }
     }
 
-    string getEmployeeType() override {
-        return "Part-Time Employee";
+    float getBaseSalary() override {
+        return hot->hourlyRate * 160;
     }
 
     void display() override {
         Employee::display();
-        cout << "Hourly Rate: $" << hourlyRate << endl;
-        cout << "Hours Work : " << hoursWorked << endl;
+        cout << "Hourly Rate: $" << hot->hourlyRate << endl;
+        cout << "Hours Work : " << getHours() << endl;
     }
 
-    int getHours() { return hoursWorked; }
+    int getHours() { return (int)hot->hours; }
 };
 
 // Intern - inherits from PartTimeEmployee
 class Intern : public PartTimeEmployee {
 private:
-    string university;
-    string mentor;
+    int universityCode;
+    int mentorCode;
 
 public:
     Intern(string id, string n, int a, string addr,
            string dept, string date, string univ, string ment, int hours)
-        : PartTimeEmployee(id, n, a, addr, dept, date, 0, 15.0, hours),
-          university(univ), mentor(ment) {}
-
-    string getEmployeeType() override {
-        return "Intern";
-    }
+        : PartTimeEmployee(id, n, a, addr, dept, date, 0, 15.0, hours, KIND_INTERN),
+          universityCode(universitySymbols.intern(univ)),
+          mentorCode(mentorSymbols.intern(ment)) {}
 
     void display() override {
         PartTimeEmployee::display();
-        cout << "University : " << university << endl;
-        cout << "Mentor     : " << mentor << endl;
+        cout << "University : " << getUniversity() << endl;
+        cout << "Mentor     : " << getMentor() << endl;
     }
 
-    string getUniversity() { return university; }
+    const string& getUniversity() { return universitySymbols.name(universityCode); }
+    const string& getMentor() { return mentorSymbols.name(mentorCode); }
 };
 
 // ================= CONTRACT EMPLOYEES =================
 
 class ContractEmployee : public Employee {
-private:
-    float contractAmount;
-    string contractEndDate;
-    bool isCompleted;
-
 public:
     ContractEmployee(string id, string n, int a, string addr,
                      string dept, string date, int exp,
                      float amount, string endDate, bool completed)
-        : Employee(id, n, a, addr, dept, date, exp),
-          contractAmount(amount), contractEndDate(endDate),
-          isCompleted(completed) {}
+        : Employee(id, n, a, addr, dept, date, exp, KIND_CONTRACT) {
+        hot->contractAmount = amount;
+        hot->contractCompleted = completed;
+        if (!endDate.empty()) coldFields().contractEndDate = endDate;
+    }
 
     float getBaseSalary() override {
-        return contractAmount;
+        return hot->contractAmount;
     }
 
-    float calculatePay() override {
-        return isCompleted ? contractAmount : contractAmount * 0.5;
+    void markCompleted() {
+        hot->contractCompleted = true;
     }
 
     void completeContract() {
-        isCompleted = true;
+        markCompleted();
         cout << name << "'s contract has been marked as completed!\n";
     }
 
-    string getEmployeeType() override {
-        return "Contract Employee";
-    }
-
     void display() override {
         Employee::display();
-        cout << "Contract   : $" << contractAmount << endl;
-        cout << "End Date   : " << contractEndDate << endl;
-        cout << "Status     : " << (isCompleted ? "Completed" : "In Progress") << endl;
+        cout << "Contract   : $" << hot->contractAmount << endl;
+        cout << "End Date   : " << getContractEndDate() << endl;
+        cout << "Status     : " << (isContractCompleted() ? "Completed" : "In Progress") << endl;
     }
 
-    bool isContractCompleted() { return isCompleted; }
+    bool isContractCompleted() { return hot->contractCompleted; }
+    string getContractEndDate() { return coldField(FIELD_CONTRACT_END, &ColdFields::contractEndDate); }
 };
 
-// ================= COMPANY CLASS =================
+// A company's employees in roster order
+using Roster = CountedVector<unique_ptr<Employee>, MEM_ROSTER>;
 
-class Company {
+// ================= MULTI-PERIOD PAYROLL ENGINE =================
+
+// Runs payroll for several pay periods in one batched pass.
+// Per-period inputs are stored column-wise: one contiguous column per
+// period, indexed by the employee's position in the roster.
+class PayrollPeriodEngine {
 private:
-    string name;
-    vector<unique_ptr<Employee>> employees;
+    int periods;
+    size_t count;
+
+    // Inputs that stay constant across periods
+    vector<float> fixedPay;
+    vector<float> hourlyRate;
+    vector<float> contractAmount;
+    vector<unsigned char> kind;
+    vector<int> deptIndex;
+    vector<unsigned char> contractOpen; // contract not yet completed (and paid)
+
+    // Per-period inputs, element [p * count + e]; hours start at zero and
+    // come only from the period inputs, never from the roster's total.
+    // completed marks the one period in which a contract completes and its
+    // amount is paid.
+    vector<float> hours;
+    vector<float> periodBonus;
+    vector<unsigned char> completed;
+
+    // Scratch columns for the period being computed
+    vector<float> periodGross;
+    vector<float> periodTax;
+
+    // Results
+    vector<float> ytdGross;
+    vector<float> ytdTax;
+    vector<double> periodTotals;
+    vector<double> periodTaxTotals;
+    vector<double> deptYtd;
+    vector<double> deptYtdTax;
+    vector<int> deptCount;
 
 public:
-    Company(string n) : name(n) {}
-
-    void addEmployee(Employee* emp) {
-        employees.push_back(unique_ptr<Employee>(emp));
+    // Seeds every period with the employee's fixed pay and rates; hours,
+    // bonuses and contract completions are zero until set per period.
+    // Contracts already completed on the roster were paid before the run.
+    PayrollPeriodEngine(const HotColumn& roster, int numPeriods)
+        : periods(numPeriods), count(roster.size()) {
+        fixedPay.resize(count);
+        hourlyRate.resize(count);
+        contractAmount.resize(count);
+        kind.resize(count);
+        deptIndex.resize(count);
+        hours.assign(count * periods, 0);
+        periodBonus.assign(count * periods, 0);
+        completed.assign(count * periods, 0);
+        contractOpen.resize(count);
+
+        for (size_t e = 0; e < count; e++) {
+            const HotRecord& h = roster[e];
+            fixedPay[e] = h.fixedPay;
+            hourlyRate[e] = h.hourlyRate;
+            contractAmount[e] = h.contractAmount;
+            kind[e] = h.kind;
+            deptIndex[e] = h.departmentCode;
+            contractOpen[e] = h.kind == KIND_CONTRACT && !h.contractCompleted;
+        }
     }
 
-    bool loadFromFile(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cout << "Error: Could not open file " << filename << endl;
-            cout << "Creating sample file...\n";
-            createSampleFile(filename);
-            file.open(filename);
-            if (!file.is_open()) {
-                return false;
-            }
-        }
+    int getPeriods() const { return periods; }
 
-        string line;
-        int lineNum = 0;
+    void addHours(int period, size_t index, float h) {
+        hours[period * count + index] += h;
+    }
 
-        while (getline(file, line)) {
-            lineNum++;
-            if (line.empty() || line[0] == '#') continue;
+    void addPeriodBonus(int period, size_t index, float amount) {
+        periodBonus[period * count + index] += amount;
+    }
 
-            stringstream ss(line);
-            string type;
-            ss >> type;
+    // Pays an open contract's amount once, in the period it completes.
+    // False if the contract was already completed.
+    bool completeContract(int period, size_t index) {
+        if (!contractOpen[index]) return false;
+        contractOpen[index] = 0;
+        completed[period * count + index] = 1;
+        return true;
+    }
 
-            try {
-                if (type == "MANAGER") {
-                    string id, name, addr, dept, date, temp;
-                    int age, exp, teamSize;
-                    float salary;
-
-                    ss >> id >> age >> exp;
-                    getline(ss, temp, '|');
-                    getline(ss, name, '|');
-                    getline(ss, addr, '|');
-                    getline(ss, dept, '|');
-                    getline(ss, date, '|');
-                    ss >> salary >> teamSize;
-
-                    addEmployee(new Manager(id, name, age, addr, dept, date, exp, salary, teamSize));
-                }
-                else if (type == "DEVELOPER") {
-                    string id, name, addr, dept, date, lang, temp;
-                    int age, exp, projects;
-                    float salary;
-
-                    ss >> id >> age >> exp;
-                    getline(ss, temp, '|');
-                    getline(ss, name, '|');
-                    getline(ss, addr, '|');
-                    getline(ss, dept, '|');
-                    getline(ss, date, '|');
-                    getline(ss, lang, '|');
-                    ss >> salary >> projects;
-
-                    addEmployee(new Developer(id, name, age, addr, dept, date, exp, salary, lang, projects));
-                }
-                else if (type == "PARTTIME") {
-                    string id, name, addr, dept, date, temp;
-                    int age, exp, hours;
-                    float rate;
-
-                    ss >> id >> age >> exp;
-                    getline(ss, temp, '|');
-                    getline(ss, name, '|');
-                    getline(ss, addr, '|');
-                    getline(ss, dept, '|');
-                    getline(ss, date, '|');
-                    ss >> rate >> hours;
-
-                    addEmployee(new PartTimeEmployee(id, name, age, addr, dept, date, exp, rate, hours));
-                }
-                else if (type == "INTERN") {
-                    string id, name, addr, dept, date, univ, mentor, temp;
-                    int age, hours;
-
-                    ss >> id >> age;
-                    getline(ss, temp, '|');
-                    getline(ss, name, '|');
-                    getline(ss, addr, '|');
-                    getline(ss, dept, '|');
-                    getline(ss, date, '|');
-                    getline(ss, univ, '|');
-                    getline(ss, mentor, '|');
-                    ss >> hours;
-
-                    addEmployee(new Intern(id, name, age, addr, dept, date, univ, mentor, hours));
-                }
-                else if (type == "CONTRACT") {
-                    string id, name, addr, dept, date, endDate, temp;
-                    int age, exp, completed;
-                    float amount;
-
-                    ss >> id >> age >> exp;
-                    getline(ss, temp, '|');
-                    getline(ss, name, '|');
-                    getline(ss, addr, '|');
-                    getline(ss, dept, '|');
-                    getline(ss, date, '|');
-                    getline(ss, endDate, '|');
-                    ss >> amount >> completed;
-
-                    addEmployee(new ContractEmployee(id, name, age, addr, dept, date, exp, amount, endDate, completed == 1));
-                }
+    // Computes gross pay and tax for every period and accumulates YTD totals
+    void run() {
+        ytdGross.assign(count, 0);
+        ytdTax.assign(count, 0);
+        periodGross.resize(count);
+        periodTax.resize(count);
+        periodTotals.assign(periods, 0);
+        periodTaxTotals.assign(periods, 0);
+        deptYtd.assign(departmentSymbols.size(), 0);
+        deptYtdTax.assign(departmentSymbols.size(), 0);
+        deptCount.assign(departmentSymbols.size(), 0);
+
+        const float* fixed = fixedPay.data();
+        const float* rate = hourlyRate.data();
+        const float* amount = contractAmount.data();
+        float* gross = periodGross.data();
+        float* tax = periodTax.data();
+        float* ytd = ytdGross.data();
+        float* ytdT = ytdTax.data();
+
+        for (int p = 0; p < periods; p++) {
+            const float* h = hours.data() + p * count;
+            const float* b = periodBonus.data() + p * count;
+            const unsigned char* c = completed.data() + p * count;
+            // Branch-free over all employee types: one formula, columns only
+            for (size_t e = 0; e < count; e++) {
+                gross[e] = fixed[e] + rate[e] * h[e] + amount[e] * c[e] + b[e];
             }
-            catch (const exception& e) {
-                cout << "Error parsing line " << lineNum << ": " << e.what() << endl;
+
+            // Tax is assessed per period, in one batch for the whole roster
+            computeTaxBatch(gross, kind.data(), tax, count);
+
+            double total = 0, totalTax = 0;
+            for (size_t e = 0; e < count; e++) {
+                ytd[e] += gross[e];
+                ytdT[e] += tax[e];
+                total += gross[e];
+                totalTax += tax[e];
             }
+            periodTotals[p] = total;
+            periodTaxTotals[p] = totalTax;
         }
 
-        file.close();
-        return true;
+        for (size_t e = 0; e < count; e++) {
+            deptYtd[deptIndex[e]] += ytd[e];
+            deptYtdTax[deptIndex[e]] += ytdT[e];
+            deptCount[deptIndex[e]]++;
+        }
     }
 
-    void createSampleFile(const string& filename) {
-        ofstream file(filename);
-        if (!file.is_open()) {
-            cout << "Error: Could not create sample file\n";
-            return;
-        }
+    float getYtdGross(size_t index) const { return ytdGross[index]; }
 
-        file << "# Employee Data File\n";
-        file << "MANAGER M001 35 10 |Alice Johnson|123 Main St|Engineering|2020-01-15| 8000 5\n";
-        file << "DEVELOPER D001 28 5 |Bob Smith|456 Oak Ave|Engineering|2021-06-01|C++| 6000 2\n";
-        file << "PARTTIME P001 45 15 |David Brown|321 Elm St|Support|2022-01-01| 25.0 80\n";
-        file << "INTERN I001 22 |Emma Davis|654 Maple Dr|Engineering|2024-09-01|Tech University|Bob Smith| 120\n";
-        file << "CONTRACT C001 40 8 |Frank Miller|987 Cedar Ln|Marketing|2024-01-01|2024-12-31| 15000 1\n";
+    double getPeriodGross(int period) const { return periodTotals[period]; }
 
-        file.close();
-        cout << "Sample file created!\n";
+    float getYtdTax(size_t index) const { return ytdTax[index]; }
+
+    double getTotalGross() const {
+        double total = 0;
+        for (double t : periodTotals) total += t;
+        return total;
     }
 
-    void displayAllEmployees() {
-        cout << "\n========================================\n";
-        cout << "      " << name << " - ALL EMPLOYEES\n";
-        cout << "========================================\n";
-        for (auto& emp : employees) {
-            emp->display();
-        }
+    double getTotalTax() const {
+        double total = 0;
+        for (double t : periodTaxTotals) total += t;
+        return total;
     }
 
-    void generateAllPayslips() {
+    void printReport(const Roster& roster, bool perEmployee) {
         cout << "\n========================================\n";
-        cout << "      GENERATING ALL PAYSLIPS\n";
+        cout << "   PAYROLL RUN - " << periods << " PERIOD(S)\n";
+        cout << "========================================\n";
+        cout << "Tax policy: " << taxPolicyName() << endl;
+        cout << fixed << setprecision(2);
+        for (int p = 0; p < periods; p++) {
+            cout << "Period " << left << setw(4) << (p + 1)
+                 << right << setw(15) << "$" << periodTotals[p]
+                 << setw(10) << "Tax $" << periodTaxTotals[p] << endl;
+        }
+        cout << "----------------------------------------\n";
+        cout << left << setw(20) << "Department"
+             << right << setw(10) << "Count"
+             << setw(15) << "YTD Gross"
+             << setw(15) << "YTD Tax" << endl;
+        cout << "----------------------------------------\n";
+
+        for (int d : departmentSymbols.sortedCodes()) {
+            if (deptCount[d] == 0) continue;
+            cout << left << setw(20) << departmentSymbols.name(d)
+                 << right << setw(10) << deptCount[d]
+                 << setw(15) << "$" << deptYtd[d]
+                 << setw(15) << "$" << deptYtdTax[d] << endl;
+        }
+
+        if (perEmployee) {
+            cout << "----------------------------------------\n";
+            cout << left << setw(10) << "ID" << setw(25) << "Name"
+                 << right << setw(15) << "YTD Gross"
+                 << setw(15) << "YTD Tax" << endl;
+            for (size_t e = 0; e < count; e++) {
+                cout << left << setw(10) << roster[e]->getID()
+                     << setw(25) << roster[e]->getName()
+                     << right << " $" << ytdGross[e]
+                     << "   $" << ytdTax[e] << endl;
+            }
+        }
+
+        cout << "========================================\n";
+        cout << "Total YTD Gross: $" << getTotalGross() << endl;
+        cout << "Total YTD Tax  : $" << getTotalTax() << endl;
+        cout << "Total YTD Net  : $" << getTotalGross() - getTotalTax() << endl;
+        cout << "========================================\n";
+    }
+};
+
+// ================= SYNTHETIC ROSTERS =================
+
+// Writes a random roster in the employees.txt format, used for benchmarks
+void generateRoster(ostream& out, int count, unsigned seed, int firstId = 0) {
+    static const char* firstNames[] = {
+        "Alice", "Bob", "Carol", "David", "Emma", "Frank", "Grace", "Henry",
+        "Isla", "Jack", "Karen", "Liam", "Mia", "Noah", "Olivia", "Paul"
+    };
+    static const char* lastNames[] = {
+        "Johnson", "Smith", "White", "Brown", "Davis", "Miller", "Chen", "Kim",
+        "Garcia", "Lee", "Turner", "Scott", "Hall", "Ross", "Bell", "Young"
+    };
+    static const char* streets[] = {
+        "Main St", "Oak Ave", "Pine Rd", "Elm St", "Maple Dr", "Cedar Ln"
+    };
+    static const char* departments[] = {
+        "Engineering", "Operations", "Sales", "Finance", "Product", "Support",
+        "HR", "Marketing", "Consulting", "IT", "Design", "Legal"
+    };
+    static const char* languages[] = {
+        "C++", "Python", "Java", "Go", "Rust", "JavaScript", "C#", "Kotlin"
+    };
+    static const char* universities[] = {
+        "Tech University", "State College", "CS University", "Business School"
+    };
+
+    mt19937 rng(seed);
+    auto pick = [&rng](int n) { return (int)(rng() % n); };
+
+    out << "# Synthetic roster: " << count << " employees, seed " << seed << "\n";
+    for (int i = firstId; i < firstId + count; i++) {
+        string name = string(firstNames[pick(16)]) + " " + lastNames[pick(16)];
+        string addr = to_string(100 + pick(900)) + " " + streets[pick(6)];
+        string dept = departments[pick(12)];
+        string date = to_string(2010 + pick(15)) + "-0" + to_string(1 + pick(9)) + "-15";
+        int age = 21 + pick(40);
+        int exp = pick(20);
+        int kind = pick(10);
+
+        if (kind == 0) {
+            out << "MANAGER M" << i << " " << age << " " << exp << " |" << name << "|"
+                << addr << "|" << dept << "|" << date << "| "
+                << 8000 + pick(4000) << " " << 2 + pick(10) << "\n";
+        } else if (kind <= 4) {
+            out << "DEVELOPER D" << i << " " << age << " " << exp << " |" << name << "|"
+                << addr << "|" << dept << "|" << date << "|" << languages[pick(8)] << "| "
+                << 5000 + pick(4000) << " " << pick(12) << "\n";
+        } else if (kind <= 6) {
+            out << "PARTTIME P" << i << " " << age << " " << exp << " |" << name << "|"
+                << addr << "|" << dept << "|" << date << "| "
+                << 20 + pick(15) << ".0 " << 40 + pick(60) << "\n";
+        } else if (kind == 7) {
+            out << "INTERN I" << i << " " << age << " |" << name << "|"
+                << addr << "|" << dept << "|" << date << "|" << universities[pick(4)] << "|"
+                << firstNames[pick(16)] << " " << lastNames[pick(16)] << "| "
+                << 80 + pick(80) << "\n";
+        } else {
+            out << "CONTRACT C" << i << " " << age << " " << exp << " |" << name << "|"
+                << addr << "|" << dept << "|" << date << "|2025-12-31| "
+                << 10000 + pick(20000) << " " << pick(2) << "\n";
+        }
+    }
+}
+
+// ================= ORG CHART =================
+
+// Reporting structure over roster positions. Children are stored in CSR
+// form and nodes are laid out in DFS preorder, so every subtree is one
+// contiguous range of positions. Structural facts (headcount, deepest
+// chain) are computed once at build. A single query sums live data over
+// its subtree's range; rollups for all nodes at once are prefix sums over
+// those ranges, refreshed by rollup().
+class OrgChart {
+private:
+    size_t count;
+    vector<int> parent;
+    vector<int> childOffsets; // children of v: childList[childOffsets[v] .. childOffsets[v + 1])
+    vector<int> childList;
+    vector<int> preorder;     // node at each preorder position
+    vector<int> position;     // preorder position of each node
+    vector<int> cycleCuts;    // nodes whose supervisor edge was cut to break a cycle
+
+    // Indexed by node
+    vector<int> subtreeSize;  // including the node itself
+    vector<int> deepestChild; // next node on the longest chain, -1 for leaves
+
+    // Prefix sums in preorder, element [i] covers positions [0, i)
+    vector<double> payPrefix;
+    vector<double> ratingPrefix;
+    vector<int> ratedPrefix;
+
+    double rangeSum(const vector<double>& prefix, int v) const {
+        int first = position[v];
+        return prefix[first + subtreeSize[v]] - prefix[first];
+    }
+
+public:
+    // parentOf[e] is the roster position of e's supervisor or -1.
+    // One edge of every reporting cycle is cut (see getCycleCuts).
+    OrgChart(vector<int> parentOf)
+        : count(parentOf.size()), parent(move(parentOf)) {
+        // Walk up from every node colouring the path; reaching a node on
+        // the current path means the walk went round a cycle, and that
+        // node's supervisor edge is cut. Nodes merely hanging below a
+        // cycle keep their supervisor.
+        vector<char> state(count, 0); // 0 unvisited, 1 on current path, 2 done
+        vector<int> path;
+        for (size_t start = 0; start < count; start++) {
+            int v = start;
+            while (v >= 0 && state[v] == 0) {
+                state[v] = 1;
+                path.push_back(v);
+                v = parent[v];
+            }
+            if (v >= 0 && state[v] == 1) {
+                cycleCuts.push_back(v);
+                parent[v] = -1;
+            }
+            for (int node : path) state[node] = 2;
+            path.clear();
+        }
+
+        // CSR adjacency by counting sort on the final parents
+        childOffsets.assign(count + 1, 0);
+        for (size_t v = 0; v < count; v++) {
+            if (parent[v] >= 0) childOffsets[parent[v] + 1]++;
+        }
+        for (size_t v = 0; v < count; v++) {
+            childOffsets[v + 1] += childOffsets[v];
+        }
+        childList.resize(childOffsets[count]);
+        vector<int> fill(childOffsets.begin(), childOffsets.end() - 1);
+        for (size_t v = 0; v < count; v++) {
+            if (parent[v] >= 0) childList[fill[parent[v]]++] = v;
+        }
+
+        // Iterative DFS from every root; with cycles cut that is everyone
+        preorder.reserve(count);
+        vector<int> stack;
+        for (size_t root = 0; root < count; root++) {
+            if (parent[root] >= 0) continue;
+            stack.push_back(root);
+            while (!stack.empty()) {
+                int v = stack.back();
+                stack.pop_back();
+                preorder.push_back(v);
+                for (int c = childOffsets[v]; c < childOffsets[v + 1]; c++) {
+                    stack.push_back(childList[c]);
+                }
+            }
+        }
+
+        position.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            position[preorder[i]] = i;
+        }
+
+        // Children follow their parent in preorder, so one reverse pass
+        // finishes every subtree before its parent is visited
+        subtreeSize.assign(count, 1);
+        deepestChild.assign(count, -1);
+        vector<int> height(count, 0);
+        for (size_t i = count; i-- > 0;) {
+            int v = preorder[i];
+            int p = parent[v];
+            if (p < 0) continue;
+            subtreeSize[p] += subtreeSize[v];
+            if (height[v] + 1 > height[p]) {
+                height[p] = height[v] + 1;
+                deepestChild[p] = v;
+            }
+        }
+    }
+
+    // Recomputes payroll and rating rollups for every node at once.
+    // pay and rating are indexed by roster position; rating 0 = unrated.
+    void rollup(const vector<float>& pay, const vector<float>& rating) {
+        payPrefix.resize(count + 1);
+        ratingPrefix.resize(count + 1);
+        ratedPrefix.resize(count + 1);
+        payPrefix[0] = ratingPrefix[0] = 0;
+        ratedPrefix[0] = 0;
+        for (size_t i = 0; i < count; i++) {
+            int v = preorder[i];
+            payPrefix[i + 1] = payPrefix[i] + pay[v];
+            ratingPrefix[i + 1] = ratingPrefix[i] + rating[v];
+            ratedPrefix[i + 1] = ratedPrefix[i] + (rating[v] > 0 ? 1 : 0);
+        }
+    }
+
+    size_t size() const { return count; }
+    const vector<int>& getCycleCuts() const { return cycleCuts; }
+    int directReports(int v) const { return childOffsets[v + 1] - childOffsets[v]; }
+
+    // Everyone below v at any depth
+    int headcount(int v) const { return subtreeSize[v] - 1; }
+
+    // v's subtree, v first, as one contiguous run of the preorder; lets a
+    // single query aggregate live data in time linear in the subtree
+    const int* subtreeBegin(int v) const { return preorder.data() + position[v]; }
+    const int* subtreeEnd(int v) const { return subtreeBegin(v) + subtreeSize[v]; }
+
+    // Pay of everyone below v, excluding v
+    double teamPayroll(int v) const {
+        return rangeSum(payPrefix, v) - (payPrefix[position[v] + 1] - payPrefix[position[v]]);
+    }
+
+    int ratedCount(int v) const {
+        int first = position[v];
+        return ratedPrefix[first + subtreeSize[v]] - ratedPrefix[first];
+    }
+
+    // Average over rated employees in v's subtree, including v
+    float averageRating(int v) const {
+        int rated = ratedCount(v);
+        return rated ? rangeSum(ratingPrefix, v) / rated : 0;
+    }
+
+    // Longest reporting chain starting at v, v first
+    vector<int> deepestChain(int v) const {
+        vector<int> chain;
+        for (int node = v; node >= 0; node = deepestChild[node]) {
+            chain.push_back(node);
+        }
+        return chain;
+    }
+};
+
+// ================= COMPANY CLASS =================
+
+class Company {
+private:
+    string name;
+    vector<unique_ptr<ColdArena>> coldArenas; // cold fields of lazily loaded employees
+    Roster employees;
+    unordered_map<string, size_t, hash<string>, equal_to<string>,
+                  CountingAllocator<pair<const string, size_t>, MEM_ID_INDEX>>
+        idIndex;                             // ID -> position in employees
+    HotColumn hot;                           // hot[e] is employees[e]'s hot record
+    unordered_map<string, string> reportsTo; // employee ID -> supervisor ID
+    unique_ptr<OrgChart> orgChart;           // rebuilt when roster or reporting lines change
+    bool reportingLinesLoaded = false;       // team sizes follow the chart only once set
+    int rejectedLines;                       // bad lines in the last strict load
+
+    // Hash of a roster line, ignoring trailing whitespace and CR
+    static size_t hashRecord(const string& line) {
+        size_t end = line.find_last_not_of(" \t\r");
+        size_t length = end == string::npos ? 0 : end + 1;
+        return hash<string_view>()(string_view(line.data(), length));
+    }
+
+    // ID is the second whitespace-separated token of every record
+    static string recordID(const string& line) {
+        const char* ws = " \t\r";
+        size_t typeStart = line.find_first_not_of(ws);
+        size_t typeEnd = line.find_first_of(ws, typeStart);
+        size_t idStart = line.find_first_not_of(ws, typeEnd);
+        if (idStart == string::npos) return "";
+        size_t idEnd = line.find_first_of(ws, idStart);
+        return line.substr(idStart, idEnd == string::npos ? string::npos : idEnd - idStart);
+    }
+
+public:
+    Company(string n) : name(n), rejectedLines(0) {}
+
+    // The index keeps the first employee with a given ID, matching the
+    // linear searches in the menu
+    void addEmployee(Employee* emp) {
+        idIndex.emplace(emp->getID(), employees.size());
+        emp->moveHotRecord(&hot.emplace_back());
+        employees.push_back(unique_ptr<Employee>(emp));
+    }
+
+    // Field extraction for parseRecord. A failed extraction leaves the
+    // stream in fail state, so one check per record catches missing or
+    // non-numeric fields; strict mode (error != nullptr) also rejects
+    // trailing text and unknown record types.
+    Employee* parseFields(const string& line, size_t* coldStart, string* error) {
+        stringstream ss(line);
+        string type;
+        ss >> type;
+
+        auto malformed = [&ss, &type, error]() {
+            if (ss.fail()) {
+                if (error) *error = "missing or non-numeric field in " + type + " record";
+                return true;
+            }
+            if (error && !(ss >> ws).eof()) {
+                *error = "unexpected text after " + type + " record";
+                return true;
+            }
+            return false;
+        };
+
+        auto readCold = [&ss, coldStart](string& field) {
+            if (coldStart) {
+                if (*coldStart == 0 && ss) *coldStart = ss.tellg();
+                ss.ignore(numeric_limits<streamsize>::max(), '|');
+            } else {
+                getline(ss, field, '|');
+            }
+        };
+
+        if (type == "MANAGER") {
+            string id, name, addr, dept, date, temp;
+            int age = 0, exp = 0, teamSize = 0;
+            float salary = 0;
+
+            ss >> id >> age >> exp;
+            getline(ss, temp, '|');
+            getline(ss, name, '|');
+            readCold(addr);
+            getline(ss, dept, '|');
+            readCold(date);
+            ss >> salary >> teamSize;
+
+            if (malformed()) return nullptr;
+            return new Manager(id, name, age, addr, dept, date, exp, salary, teamSize);
+        }
+        else if (type == "DEVELOPER") {
+            string id, name, addr, dept, date, lang, temp;
+            int age = 0, exp = 0, projects = 0;
+            float salary = 0;
+
+            ss >> id >> age >> exp;
+            getline(ss, temp, '|');
+            getline(ss, name, '|');
+            readCold(addr);
+            getline(ss, dept, '|');
+            readCold(date);
+            getline(ss, lang, '|');
+            ss >> salary >> projects;
+
+            if (malformed()) return nullptr;
+            return new Developer(id, name, age, addr, dept, date, exp, salary, lang, projects);
+        }
+        else if (type == "PARTTIME") {
+            string id, name, addr, dept, date, temp;
+            int age = 0, exp = 0, hours = 0;
+            float rate = 0;
+
+            ss >> id >> age >> exp;
+            getline(ss, temp, '|');
+            getline(ss, name, '|');
+            readCold(addr);
+            getline(ss, dept, '|');
+            readCold(date);
+            ss >> rate >> hours;
+
+            if (malformed()) return nullptr;
+            return new PartTimeEmployee(id, name, age, addr, dept, date, exp, rate, hours);
+        }
+        else if (type == "INTERN") {
+            string id, name, addr, dept, date, univ, mentor, temp;
+            int age = 0, hours = 0;
+
+            ss >> id >> age;
+            getline(ss, temp, '|');
+            getline(ss, name, '|');
+            readCold(addr);
+            getline(ss, dept, '|');
+            readCold(date);
+            getline(ss, univ, '|');
+            getline(ss, mentor, '|');
+            ss >> hours;
+
+            if (malformed()) return nullptr;
+            return new Intern(id, name, age, addr, dept, date, univ, mentor, hours);
+        }
+        else if (type == "CONTRACT") {
+            string id, name, addr, dept, date, endDate, temp;
+            int age = 0, exp = 0, completed = 0;
+            float amount = 0;
+
+            ss >> id >> age >> exp;
+            getline(ss, temp, '|');
+            getline(ss, name, '|');
+            readCold(addr);
+            getline(ss, dept, '|');
+            readCold(date);
+            readCold(endDate);
+            ss >> amount >> completed;
+
+            if (malformed()) return nullptr;
+            return new ContractEmployee(id, name, age, addr, dept, date, exp, amount, endDate, completed == 1);
+        }
+        if (error && !type.empty()) *error = "unknown record type " + type;
+        return nullptr;
+    }
+
+    // Range checks applied to every record in strict mode
+    static string validateRecord(Employee* emp) {
+        PayComponents pc = emp->getPayComponents();
+        if (emp->getID().empty()) return "missing ID";
+        if (emp->getName().empty()) return "missing name for " + emp->getID();
+        if (emp->getDepartment().empty()) return "missing department for " + emp->getID();
+        if (emp->getAge() < 14 || emp->getAge() > 100) return "age out of range for " + emp->getID();
+        if (emp->getExperience() < 0 || emp->getExperience() > 80) {
+            return "experience out of range for " + emp->getID();
+        }
+        if (!(pc.fixedPay >= 0) || !(pc.hourlyRate >= 0) || !(pc.contractAmount >= 0) ||
+            !(pc.hours >= 0) || !isfinite(emp->calculatePay())) {
+            return "negative or invalid pay for " + emp->getID();
+        }
+        return "";
+    }
+
+    // Builds an employee from one roster line; nullptr for unknown types
+    // and malformed records. Passing `coldStart` skips the cold text fields
+    // rather than copying them and stores where they begin in the line.
+    // Passing `error` turns on strict validation and receives the reason
+    // a line was rejected.
+    Employee* parseRecord(const string& line, size_t* coldStart = nullptr, string* error = nullptr) {
+        Employee* emp = parseFields(line, coldStart, error);
+        if (emp && error) {
+            *error = validateRecord(emp);
+            if (!error->empty()) {
+                delete emp;
+                return nullptr;
+            }
+        }
+        return emp;
+    }
+
+    bool loadFromFile(const string& filename, bool lazy = false, bool strict = false) {
+        if (lazy) {
+            // The roster text is only needed while parsing
+            ifstream file(filename, ios::binary | ios::ate);
+            if (file.is_open()) {
+                string text(file.tellg(), '\0');
+                file.seekg(0);
+                file.read(&text[0], text.size());
+                if (text.size() <= ColdArena::MAX_SIZE) return loadLazy(text, strict);
+                cout << "Roster too large to load lazily; loading eagerly.\n";
+            }
+        }
+
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cout << "Error: Could not open file " << filename << endl;
+            cout << "Creating sample file...\n";
+            createSampleFile(filename);
+            file.open(filename);
+            if (!file.is_open()) {
+                return false;
+            }
+        }
+
+        bool ok = loadFromStream(file, strict);
+        file.close();
+        return ok;
+    }
+
+    // Leaves address, join date and contract end date unparsed: each
+    // record's cold span is copied into a cold arena and split only when
+    // displayed
+    bool loadLazy(const string& roster, bool strict = false) {
+        // The arena holds part of the text, so a roster within the limit
+        // always fits
+        if (roster.size() > ColdArena::MAX_SIZE) {
+            cout << "Error: Roster too large to load lazily (4 GiB limit)\n";
+            return false;
+        }
+        unique_ptr<ColdArena> arena(new ColdArena());
+        const char* text = roster.data();
+        size_t size = roster.size();
+        size_t offset = 0;
+        int lineNum = 0;
+        string problem;
+        rejectedLines = 0;
+
+        while (offset < size) {
+            const char* newline = (const char*)memchr(text + offset, '\n', size - offset);
+            size_t end = newline ? newline - text : size;
+            size_t length = end - offset;
+            if (length > 0 && text[end - 1] == '\r') length--;
+            lineNum++;
+
+            if (length > 0 && text[offset] != '#') {
+                string line(text + offset, length);
+                size_t coldStart = 0;
+                try {
+                    Employee* emp = parseRecord(line, &coldStart, strict ? &problem : nullptr);
+                    if (emp) {
+                        emp->setRecordHash(hashRecord(line));
+                        size_t coldEnd = coldSpanEnd(line, coldStart, emp->getKind());
+                        emp->setColdRecord(arena.get(), arena->append(line.data() + coldStart, coldEnd - coldStart),
+                                           coldEnd - coldStart);
+                        addEmployee(emp);
+                    } else if (strict) {
+                        reportBadLine(lineNum, problem);
+                    }
+                }
+                catch (const exception& e) {
+                    cout << "Error parsing line " << lineNum << ": " << e.what() << endl;
+                }
+            }
+            offset = end + 1;
+        }
+
+        arena->shrinkToFit();
+        coldArenas.push_back(move(arena));
+        if (strict) reportRejected();
+        return true;
+    }
+
+    // End of the last cold field this kind of record uses
+    static size_t coldSpanEnd(const string& line, size_t coldStart, EmployeeKind kind) {
+        int fields = (kind == KIND_CONTRACT ? FIELD_CONTRACT_END : FIELD_JOIN_DATE) + 1;
+        size_t end = coldStart;
+        for (int i = 0; i < fields; i++) {
+            end = line.find('|', end + (i > 0));
+            if (end == string::npos) return line.size();
+        }
+        return end;
+    }
+
+    // Malformed lines are always skipped; strict mode validates every
+    // record and reports each rejected line
+    bool loadFromStream(istream& file, bool strict = false) {
+        string line;
+        int lineNum = 0;
+        string problem;
+        rejectedLines = 0;
+
+        while (getline(file, line)) {
+            lineNum++;
+            if (line.empty() || line[0] == '#') continue;
+
+            try {
+                Employee* emp = parseRecord(line, nullptr, strict ? &problem : nullptr);
+                if (emp) {
+                    emp->setRecordHash(hashRecord(line));
+                    addEmployee(emp);
+                } else if (strict) {
+                    reportBadLine(lineNum, problem);
+                }
+            }
+            catch (const exception& e) {
+                cout << "Error parsing line " << lineNum << ": " << e.what() << endl;
+            }
+        }
+
+        if (strict) reportRejected();
+        return true;
+    }
+
+    void reportBadLine(int lineNum, const string& problem) {
+        if (problem.empty()) return; // blank line
+        rejectedLines++;
+        cout << "Line " << lineNum << ": " << problem << endl;
+    }
+
+    void reportRejected() {
+        if (rejectedLines > 0) {
+            cout << rejectedLines << " bad line(s) rejected.\n";
+        }
+    }
+
+    int getRejectedLines() { return rejectedLines; }
+
+    void createSampleFile(const string& filename) {
+        ofstream file(filename);
+        if (!file.is_open()) {
+            cout << "Error: Could not create sample file\n";
+            return;
+        }
+
+        file << "# Employee Data File\n";
+        file << "MANAGER M001 35 10 |Alice Johnson|123 Main St|Engineering|2020-01-15| 8000 5\n";
+        file << "DEVELOPER D001 28 5 |Bob Smith|456 Oak Ave|Engineering|2021-06-01|C++| 6000 2\n";
+        file << "PARTTIME P001 45 15 |David Brown|321 Elm St|Support|2022-01-01| 25.0 80\n";
+        file << "INTERN I001 22 |Emma Davis|654 Maple Dr|Engineering|2024-09-01|Tech University|Bob Smith| 120\n";
+        file << "CONTRACT C001 40 8 |Frank Miller|987 Cedar Ln|Marketing|2024-01-01|2024-12-31| 15000 1\n";
+
+        file.close();
+        cout << "Sample file created!\n";
+    }
+
+    struct ReconcileSummary {
+        int added = 0;
+        int removed = 0;
+        int changed = 0;
+        int unchanged = 0;
+        int skipped = 0;
+        vector<string> addedIDs;
+        vector<string> removedIDs;
+        vector<string> changedIDs;
+    };
+
+    // Diffs a full roster against the live company by ID and applies only
+    // the differences. Unchanged records are recognised by their hash and
+    // never parsed; changed records keep their in-memory state.
+    ReconcileSummary reconcileFromStream(istream& file) {
+        ReconcileSummary summary;
+        size_t originalCount = employees.size();
+        vector<char> seen(originalCount, 0);
+        string line;
+        int lineNum = 0;
+
+        while (getline(file, line)) {
+            lineNum++;
+            if (line.empty() || line[0] == '#') continue;
+
+            string id = recordID(line);
+            if (id.empty()) continue;
+            size_t h = hashRecord(line);
+            auto it = idIndex.find(id);
+
+            if (it != idIndex.end() && (it->second >= originalCount || seen[it->second])) {
+                cout << "Duplicate ID " << id << " on line " << lineNum << " skipped\n";
+                summary.skipped++;
+                continue;
+            }
+            if (it != idIndex.end()) {
+                size_t pos = it->second;
+                seen[pos] = 1;
+                if (employees[pos]->getRecordHash() == h) {
+                    summary.unchanged++;
+                    continue;
+                }
+            }
+
+            try {
+                Employee* emp = parseRecord(line);
+                if (!emp) {
+                    summary.skipped++;
+                    continue;
+                }
+                emp->setRecordHash(h);
+                if (it != idIndex.end()) {
+                    emp->carryStateFrom(*employees[it->second]);
+                    emp->moveHotRecord(&hot[it->second]);
+                    employees[it->second].reset(emp);
+                    summary.changed++;
+                    summary.changedIDs.push_back(id);
+                } else {
+                    addEmployee(emp);
+                    summary.added++;
+                    summary.addedIDs.push_back(id);
+                }
+            }
+            catch (const exception& e) {
+                cout << "Error parsing line " << lineNum << ": " << e.what() << endl;
+                summary.skipped++;
+            }
+        }
+
+        // Compact out records missing from the new file; only entries
+        // that actually move get their index position updated
+        // (a duplicate ID left over from loading is not the indexed entry)
+        size_t write = 0;
+        for (size_t read = 0; read < employees.size(); read++) {
+            bool removed = read < originalCount && !seen[read];
+            if (removed || write != read) {
+                auto indexed = idIndex.find(employees[read]->getID());
+                if (indexed != idIndex.end() && indexed->second == read) {
+                    if (removed) idIndex.erase(indexed);
+                    else indexed->second = write;
+                }
+            }
+            if (removed) {
+                summary.removed++;
+                summary.removedIDs.push_back(employees[read]->getID());
+                continue;
+            }
+            if (write != read) {
+                employees[write] = move(employees[read]);
+                employees[write]->moveHotRecord(&hot[write]);
+            }
+            write++;
+        }
+        employees.resize(write);
+        hot.resize(write);
+        if (orgChart) refreshOrgChart();
+
+        return summary;
+    }
+
+    void printReconcileSummary(const ReconcileSummary& summary) {
+        const size_t listLimit = 10;
+        auto printIDs = [listLimit](const char* label, const vector<string>& ids) {
+            if (ids.empty()) return;
+            cout << label;
+            for (size_t i = 0; i < ids.size() && i < listLimit; i++) {
+                cout << " " << ids[i];
+            }
+            if (ids.size() > listLimit) cout << " ... (" << ids.size() - listLimit << " more)";
+            cout << endl;
+        };
+
+        cout << "\n========================================\n";
+        cout << "      ROSTER RECONCILE SUMMARY\n";
+        cout << "========================================\n";
+        cout << "Added     : " << summary.added << endl;
+        cout << "Removed   : " << summary.removed << endl;
+        cout << "Changed   : " << summary.changed << endl;
+        cout << "Unchanged : " << summary.unchanged << endl;
+        cout << "Skipped   : " << summary.skipped << endl;
+        cout << "----------------------------------------\n";
+        printIDs("+", summary.addedIDs);
+        printIDs("-", summary.removedIDs);
+        printIDs("~", summary.changedIDs);
+        cout << "========================================\n";
+    }
+
+    void reconcileRosterFile() {
+        string filename;
+        cout << "Enter roster file to reconcile: ";
+        cin >> filename;
+
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cout << "Error: Could not open file " << filename << endl;
+            return;
+        }
+        printReconcileSummary(reconcileFromStream(file));
+        cout << employees.size() << " employees after reconcile.\n";
+    }
+
+    void displayAllEmployees() {
+        cout << "\n========================================\n";
+        cout << "      " << name << " - ALL EMPLOYEES\n";
+        cout << "========================================\n";
+        for (auto& emp : employees) {
+            emp->display();
+        }
+    }
+
+    void generateAllPayslips() {
+        cout << "\n========================================\n";
+        cout << "      GENERATING ALL PAYSLIPS\n";
         cout << "========================================\n";
         for (auto& emp : employees) {
             emp->generatePaySlip();
@@ -559,8 +1891,8 @@ public:
 
     void showTotalPayroll() {
         float total = 0;
-        for (auto& emp : employees) {
-            total += emp->calculatePay();
+        for (const HotRecord& h : hot) {
+            total += h.pay();
         }
         cout << "\n========================================\n";
         cout << "Total Payroll: $" << fixed << setprecision(2) << total << endl;
@@ -604,10 +1936,11 @@ public:
         getline(cin, dept);
 
         cout << "\n--- Employees in " << dept << " ---\n";
+        int code = departmentSymbols.find(dept);
         bool found = false;
-        for (auto& emp : employees) {
-            if (emp->getDepartment() == dept) {
-                emp->display();
+        for (size_t e = 0; e < employees.size(); e++) {
+            if (hot[e].departmentCode == code) {
+                employees[e]->display();
                 found = true;
             }
         }
@@ -615,13 +1948,12 @@ public:
     }
 
     void showDepartmentStats() {
-        map<string, int> deptCount;
-        map<string, float> deptPayroll;
+        CountedVector<int, MEM_QUERY> deptCount(departmentSymbols.size(), 0);
+        CountedVector<float, MEM_QUERY> deptPayroll(departmentSymbols.size(), 0);
 
-        for (auto& emp : employees) {
-            string dept = emp->getDepartment();
-            deptCount[dept]++;
-            deptPayroll[dept] += emp->calculatePay();
+        for (const HotRecord& h : hot) {
+            deptCount[h.departmentCode]++;
+            deptPayroll[h.departmentCode] += h.pay();
         }
 
         cout << "\n========================================\n";
@@ -632,34 +1964,35 @@ public:
              << setw(15) << "Payroll" << endl;
         cout << "----------------------------------------\n";
 
-        for (auto& pair : deptCount) {
-            cout << left << setw(20) << pair.first
-                 << right << setw(10) << pair.second
+        for (int dept : departmentSymbols.sortedCodes()) {
+            if (deptCount[dept] == 0) continue;
+            cout << left << setw(20) << departmentSymbols.name(dept)
+                 << right << setw(10) << deptCount[dept]
                  << setw(15) << fixed << setprecision(2)
-                 << "$" << deptPayroll[pair.first] << endl;
+                 << "$" << deptPayroll[dept] << endl;
         }
     }
 
     void topEarners() {
-        vector<pair<string, float>> earnings;
-
-        for (auto& emp : employees) {
-            earnings.push_back({emp->getName(), emp->calculatePay()});
+        CountedVector<pair<float, int>, MEM_QUERY> earnings;
+        earnings.reserve(hot.size());
+        for (size_t e = 0; e < hot.size(); e++) {
+            earnings.push_back({hot[e].pay(), (int)e});
         }
 
-        sort(earnings.begin(), earnings.end(),
-             [](const pair<string, float>& a, const pair<string, float>& b) {
-                 return a.second > b.second;
-             });
+        int count = min(10, (int)earnings.size());
+        partial_sort(earnings.begin(), earnings.begin() + count, earnings.end(),
+                     [](const pair<float, int>& a, const pair<float, int>& b) {
+                         return a.first > b.first;
+                     });
 
         cout << "\n========================================\n";
         cout << "      TOP 10 EARNERS\n";
         cout << "========================================\n";
 
-        int count = min(10, (int)earnings.size());
         for (int i = 0; i < count; i++) {
-            cout << (i+1) << ". " << left << setw(25) << earnings[i].first
-                 << " $" << fixed << setprecision(2) << earnings[i].second << endl;
+            cout << (i+1) << ". " << left << setw(25) << employees[earnings[i].second]->getName()
+                 << " $" << fixed << setprecision(2) << earnings[i].first << endl;
         }
     }
 
@@ -737,7 +2070,8 @@ public:
     }
 
     void showEmployeesByExperience() {
-        vector<Employee*> sortedEmps;
+        CountedVector<Employee*, MEM_QUERY> sortedEmps;
+        sortedEmps.reserve(employees.size());
         for (auto& emp : employees) {
             sortedEmps.push_back(emp.get());
         }
@@ -779,19 +2113,338 @@ public:
         cout << "Employee not found!\n";
     }
 
-    void completeProjectForDeveloper() {
-        string id;
-        cout << "Enter Developer ID: ";
-        cin >> id;
+    // Outcome of a batch mutation. Batches validate every staged value
+    // before writing any of them, so a failed batch changes nothing.
+    struct BatchResult {
+        bool committed = false;
+        int affected = 0;
+        double payrollDelta = 0;
+        vector<string> errors;
+    };
+
+    static bool isFullTime(Employee* emp) {
+        EmployeeKind kind = emp->getKind();
+        return kind == KIND_FULLTIME || kind == KIND_MANAGER || kind == KIND_DEVELOPER;
+    }
 
-        for (auto& emp : employees) {
-            if (emp->getID() == id) {
-                Developer* dev = dynamic_cast<Developer*>(emp.get());
-                if (dev) {
-                    dev->completeProject();
-                } else {
-                    cout << "This employee is not a developer!\n";
-                }
+    // Raise for every full-time employee in `department` (empty = all)
+    // whose average rating is at least `minRating` (0 = no filter)
+    BatchResult bulkRaise(float percentage, const string& department, float minRating) {
+        BatchResult result;
+        int deptCode = department.empty() ? -1 : departmentSymbols.find(department);
+        if (!department.empty() && deptCode < 0) {
+            result.errors.push_back("Unknown department " + department);
+            return result;
+        }
+        if (!(percentage > -100)) {
+            result.errors.push_back("Raise percentage must be greater than -100");
+            return result;
+        }
+
+        // Type and department filters run on the hot column; only
+        // candidates have their review history read
+        vector<FullTimeEmployee*> selected;
+        for (size_t e = 0; e < employees.size(); e++) {
+            const HotRecord& h = hot[e];
+            if (h.kind != KIND_FULLTIME && h.kind != KIND_MANAGER && h.kind != KIND_DEVELOPER) continue;
+            if (deptCode >= 0 && h.departmentCode != deptCode) continue;
+            if (minRating > 0 && employees[e]->getAverageRating() < minRating) continue;
+            selected.push_back(static_cast<FullTimeEmployee*>(employees[e].get()));
+        }
+
+        // Stage old and new salaries as columns; the raise itself is one
+        // branch-free loop over the column
+        size_t n = selected.size();
+        vector<float> salary(n), raised(n);
+        for (size_t i = 0; i < n; i++) {
+            salary[i] = selected[i]->getMonthlySalary();
+        }
+        float factor = percentage / 100;
+        for (size_t i = 0; i < n; i++) {
+            raised[i] = salary[i] + salary[i] * factor;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            if (!isfinite(raised[i])) {
+                result.errors.push_back("Invalid salary for " + selected[i]->getID());
+            }
+        }
+        if (!result.errors.empty()) return result;
+
+        for (size_t i = 0; i < n; i++) {
+            selected[i]->setMonthlySalary(raised[i]);
+            result.payrollDelta += raised[i] - salary[i];
+        }
+        result.committed = true;
+        result.affected = n;
+        return result;
+    }
+
+    // Sets bonuses from an (ID, amount) table; every ID must be a
+    // full-time employee listed once with a non-negative amount
+    BatchResult bulkSetBonus(const vector<pair<string, float>>& table) {
+        BatchResult result;
+        vector<FullTimeEmployee*> selected;
+        vector<char> listed(employees.size(), 0);
+
+        for (const auto& entry : table) {
+            auto it = idIndex.find(entry.first);
+            if (it == idIndex.end()) {
+                result.errors.push_back("Unknown employee " + entry.first);
+                continue;
+            }
+            Employee* emp = employees[it->second].get();
+            if (!isFullTime(emp)) {
+                result.errors.push_back(entry.first + " is not a full-time employee");
+            } else if (listed[it->second]) {
+                result.errors.push_back(entry.first + " is listed more than once");
+            } else if (!(entry.second >= 0) || !isfinite(entry.second)) {
+                result.errors.push_back("Invalid bonus for " + entry.first);
+            }
+            listed[it->second] = 1;
+            selected.push_back(static_cast<FullTimeEmployee*>(emp));
+        }
+        if (!result.errors.empty()) return result;
+
+        for (size_t i = 0; i < selected.size(); i++) {
+            result.payrollDelta += table[i].second - selected[i]->getBonus();
+            selected[i]->setBonus(table[i].second);
+        }
+        result.committed = true;
+        result.affected = selected.size();
+        return result;
+    }
+
+    void printBatchResult(const string& title, const BatchResult& result) {
+        cout << "\n========================================\n";
+        cout << "      " << title << endl;
+        cout << "========================================\n";
+        if (!result.committed) {
+            cout << "Batch rejected, no changes applied:\n";
+            for (size_t i = 0; i < result.errors.size() && i < 10; i++) {
+                cout << "  " << result.errors[i] << endl;
+            }
+            if (result.errors.size() > 10) {
+                cout << "  ... (" << result.errors.size() - 10 << " more)\n";
+            }
+            return;
+        }
+        cout << "Employees updated : " << result.affected << endl;
+        cout << "Monthly payroll   : " << (result.payrollDelta >= 0 ? "+$" : "-$")
+             << fixed << setprecision(2) << fabs(result.payrollDelta) << endl;
+        cout << "========================================\n";
+    }
+
+    void bulkRaiseByCriteria() {
+        string dept;
+        float minRating, percentage;
+
+        cout << "Enter Department (blank for all): ";
+        cin.ignore();
+        getline(cin, dept);
+        cout << "Minimum average rating (0 for any): ";
+        cin >> minRating;
+        cout << "Enter raise percentage: ";
+        cin >> percentage;
+
+        printBatchResult("BULK RAISE", bulkRaise(percentage, dept, minRating));
+    }
+
+    void bulkBonusFromFile() {
+        string filename;
+        cout << "Enter bonus table file (ID AMOUNT per line): ";
+        cin >> filename;
+
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cout << "Error: Could not open file " << filename << endl;
+            return;
+        }
+
+        // A line that does not parse rejects the whole table
+        vector<pair<string, float>> table;
+        vector<string> badLines;
+        string line;
+        int lineNum = 0;
+        while (getline(file, line)) {
+            lineNum++;
+            if (line.empty() || line[0] == '#') continue;
+            stringstream ss(line);
+            string id, extra;
+            float amount;
+            if (ss >> id >> amount && !(ss >> extra)) {
+                table.push_back({id, amount});
+            } else {
+                badLines.push_back("Line " + to_string(lineNum) + ": expected ID AMOUNT");
+            }
+        }
+
+        BatchResult result;
+        if (badLines.empty()) {
+            result = bulkSetBonus(table);
+        } else {
+            result.errors = badLines;
+        }
+        printBatchResult("BULK BONUS", result);
+    }
+
+    // Reads "EMPLOYEE_ID SUPERVISOR_ID" lines and rebuilds the org chart.
+    // A line that does not parse rejects the file and keeps the old chart.
+    bool loadReportingLines(const string& filename) {
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cout << "Error: Could not open file " << filename << endl;
+            return false;
+        }
+
+        unordered_map<string, string> lines;
+        vector<string> errors;
+        string line;
+        int lineNum = 0;
+        while (getline(file, line)) {
+            lineNum++;
+            if (line.empty() || line[0] == '#') continue;
+            stringstream ss(line);
+            string id, supervisor, extra;
+            if (ss >> id >> supervisor && !(ss >> extra)) {
+                lines[id] = supervisor;
+            } else {
+                errors.push_back("Line " + to_string(lineNum) + ": expected EMPLOYEE_ID SUPERVISOR_ID");
+            }
+        }
+
+        if (!errors.empty()) {
+            cout << "Reporting lines rejected, org chart unchanged:\n";
+            for (size_t i = 0; i < errors.size() && i < 10; i++) {
+                cout << "  " << errors[i] << endl;
+            }
+            if (errors.size() > 10) {
+                cout << "  ... (" << errors.size() - 10 << " more)\n";
+            }
+            return false;
+        }
+
+        reportsTo = move(lines);
+        reportingLinesLoaded = true;
+        for (const auto& warning : refreshOrgChart()) {
+            cout << "Warning: " << warning << endl;
+        }
+        return true;
+    }
+
+    // Builds the org chart from the explicit reporting lines; interns
+    // without one report to their mentor when the name is unambiguous.
+    // Once reporting lines have been loaded, managers with reports in the
+    // chart have their team size set to their real direct reports; the
+    // others keep the roster's figure.
+    vector<string> refreshOrgChart() {
+        unordered_map<string, int> byName;
+        for (size_t e = 0; e < employees.size(); e++) {
+            auto inserted = byName.emplace(employees[e]->getName(), (int)e);
+            if (!inserted.second) inserted.first->second = -1; // ambiguous
+        }
+
+        vector<string> warnings;
+        vector<int> parentOf(employees.size(), -1);
+        for (size_t e = 0; e < employees.size(); e++) {
+            Employee* emp = employees[e].get();
+            auto explicitLine = reportsTo.find(emp->getID());
+            if (explicitLine != reportsTo.end()) {
+                auto it = idIndex.find(explicitLine->second);
+                if (it == idIndex.end()) {
+                    warnings.push_back(emp->getID() + " reports to unknown " + explicitLine->second);
+                } else if (it->second == e) {
+                    warnings.push_back(emp->getID() + " cannot report to itself");
+                } else {
+                    parentOf[e] = it->second;
+                }
+            } else if (emp->getKind() == KIND_INTERN) {
+                auto it = byName.find(static_cast<Intern*>(emp)->getMentor());
+                if (it != byName.end() && it->second >= 0 && it->second != (int)e) {
+                    parentOf[e] = it->second;
+                }
+            }
+        }
+
+        orgChart.reset(new OrgChart(move(parentOf)));
+        for (int v : orgChart->getCycleCuts()) {
+            warnings.push_back("Reporting cycle cut at " + employees[v]->getID());
+        }
+
+        if (!reportingLinesLoaded) return warnings;
+        for (size_t e = 0; e < employees.size(); e++) {
+            int reports = orgChart->directReports(e);
+            if (employees[e]->getKind() == KIND_MANAGER && reports > 0) {
+                static_cast<Manager*>(employees[e].get())->setTeamSize(reports);
+            }
+        }
+        return warnings;
+    }
+
+    void loadReportingFile() {
+        string filename;
+        cout << "Enter reporting lines file (EMPLOYEE_ID SUPERVISOR_ID per line): ";
+        cin >> filename;
+        if (loadReportingLines(filename)) {
+            cout << "Org chart built for " << orgChart->size() << " employees.\n";
+        }
+    }
+
+    void showOrgRollup() {
+        string id;
+        cout << "Enter Manager ID: ";
+        cin >> id;
+
+        auto it = idIndex.find(id);
+        if (it == idIndex.end()) {
+            cout << "Employee not found!\n";
+            return;
+        }
+        if (!orgChart) refreshOrgChart();
+
+        // Pay and ratings change between queries, so sum fresh data over
+        // the subtree only
+        int v = it->second;
+        double teamPayroll = 0, ratingSum = 0;
+        int rated = 0;
+        for (const int* node = orgChart->subtreeBegin(v); node != orgChart->subtreeEnd(v); node++) {
+            if (*node != v) teamPayroll += hot[*node].pay();
+            float rating = employees[*node]->getAverageRating();
+            if (rating > 0) {
+                ratingSum += rating;
+                rated++;
+            }
+        }
+
+        Employee* emp = employees[v].get();
+        vector<int> chain = orgChart->deepestChain(v);
+
+        cout << "\n--- Org Rollup for " << emp->getName() << " ---\n";
+        cout << "Direct Reports : " << orgChart->directReports(v) << endl;
+        cout << "Headcount      : " << orgChart->headcount(v) << " (all levels)\n";
+        cout << "Team Payroll   : $" << fixed << setprecision(2) << teamPayroll << endl;
+        cout << "Average Rating : " << (rated ? ratingSum / rated : 0) << "/5 ("
+             << rated << " rated)\n";
+        cout << "Deepest Chain  : " << chain.size() - 1 << " level(s): ";
+        for (size_t i = 0; i < chain.size(); i++) {
+            cout << (i ? " -> " : "") << employees[chain[i]]->getID();
+        }
+        cout << endl;
+    }
+
+    void completeProjectForDeveloper() {
+        string id;
+        cout << "Enter Developer ID: ";
+        cin >> id;
+
+        for (auto& emp : employees) {
+            if (emp->getID() == id) {
+                Developer* dev = dynamic_cast<Developer*>(emp.get());
+                if (dev) {
+                    dev->completeProject();
+                } else {
+                    cout << "This employee is not a developer!\n";
+                }
                 return;
             }
         }
@@ -832,6 +2485,12 @@ public:
             return;
         }
 
+        writeReport(file);
+        file.close();
+        cout << "Report exported successfully to " << filename << "!\n";
+    }
+
+    void writeReport(ostream& file) {
         file << "EMPLOYEE REPORT - " << name << "\n";
         file << "===========================================\n\n";
 
@@ -844,9 +2503,139 @@ public:
                  << emp->calculatePay() << "\n";
             file << "-------------------------------------------\n";
         }
+    }
 
-        file.close();
-        cout << "Report exported successfully to " << filename << "!\n";
+    void runMultiPeriodPayroll() {
+        int periods;
+        cout << "Enter number of pay periods (1-12): ";
+        cin >> periods;
+        if (periods < 1 || periods > 12) {
+            cout << "Invalid number of periods!\n";
+            return;
+        }
+
+        string filename;
+        cout << "Enter period input file (ID PERIOD HOURS BONUS COMPLETED, - for none): ";
+        cin >> filename;
+
+        PayrollPeriodEngine engine(hot, periods);
+        if (filename != "-") {
+            ifstream file(filename);
+            if (!file.is_open()) {
+                cout << "Error: Could not open file " << filename << endl;
+                return;
+            }
+            if (!loadPeriodInputs(file, engine)) return;
+        }
+        engine.run();
+        engine.printReport(employees, employees.size() <= 100);
+    }
+
+    // Reads "ID PERIOD HOURS BONUS COMPLETED" lines (PERIOD from 1,
+    // COMPLETED 0 or 1) into the engine. COMPLETED=1 pays an open contract
+    // in that period, so it may appear once per contract. Every line is
+    // checked first; any bad line rejects the whole file and leaves the
+    // engine untouched.
+    bool loadPeriodInputs(istream& file, PayrollPeriodEngine& engine) {
+        struct PeriodInput {
+            size_t index;
+            int period;
+            float hours;
+            float bonus;
+            int completed;
+        };
+        vector<PeriodInput> inputs;
+        vector<string> errors;
+        vector<char> completing(employees.size(), 0);
+        string line;
+        int lineNum = 0;
+
+        while (getline(file, line)) {
+            lineNum++;
+            if (line.empty() || line[0] == '#') continue;
+            stringstream ss(line);
+            string id, extra;
+            PeriodInput in = {0, 0, 0, 0, 0};
+            string at = "Line " + to_string(lineNum) + ": ";
+            if (!(ss >> id >> in.period >> in.hours >> in.bonus >> in.completed) || ss >> extra) {
+                errors.push_back(at + "expected ID PERIOD HOURS BONUS COMPLETED");
+                continue;
+            }
+            auto it = idIndex.find(id);
+            if (it == idIndex.end()) {
+                errors.push_back(at + "unknown employee " + id);
+                continue;
+            }
+            in.index = it->second;
+            EmployeeKind kind = employees[in.index]->getKind();
+            if (in.period < 1 || in.period > engine.getPeriods()) {
+                errors.push_back(at + "period must be between 1 and " + to_string(engine.getPeriods()));
+            } else if (!(in.hours >= 0) || !isfinite(in.hours) || !(in.bonus >= 0) || !isfinite(in.bonus)) {
+                errors.push_back(at + "hours and bonus must be non-negative");
+            } else if (in.hours > 0 && kind != KIND_PARTTIME && kind != KIND_INTERN) {
+                errors.push_back(at + id + " is not paid by the hour");
+            } else if (in.completed != 0 && (in.completed != 1 || kind != KIND_CONTRACT)) {
+                errors.push_back(at + "COMPLETED must be 0, or 1 for a contract employee");
+            } else if (in.completed && static_cast<ContractEmployee*>(employees[in.index].get())->isContractCompleted()) {
+                errors.push_back(at + id + "'s contract is already completed");
+            } else if (in.completed && completing[in.index]) {
+                errors.push_back(at + id + " is completed more than once");
+            } else {
+                if (in.completed) completing[in.index] = 1;
+                in.period--;
+                inputs.push_back(in);
+            }
+        }
+
+        if (!errors.empty()) {
+            cout << "Period inputs rejected, payroll not run:\n";
+            for (size_t i = 0; i < errors.size() && i < 10; i++) {
+                cout << "  " << errors[i] << endl;
+            }
+            if (errors.size() > 10) {
+                cout << "  ... (" << errors.size() - 10 << " more)\n";
+            }
+            return false;
+        }
+
+        for (const PeriodInput& in : inputs) {
+            engine.addHours(in.period, in.index, in.hours);
+            engine.addPeriodBonus(in.period, in.index, in.bonus);
+            if (in.completed) engine.completeContract(in.period, in.index);
+        }
+        return true;
+    }
+
+    void selectTaxPolicy() {
+        int choice;
+        cout << "Current tax policy: " << taxPolicyName() << endl;
+        cout << "1. " << FlatTaxPolicy::NAME << endl;
+        cout << "2. " << ProgressiveTaxPolicy::NAME << endl;
+        cout << "Enter choice: ";
+        cin >> choice;
+
+        if (choice == 1) {
+            activeTaxPolicy = TAX_FLAT;
+        } else if (choice == 2) {
+            activeTaxPolicy = TAX_PROGRESSIVE;
+        } else {
+            cout << "Invalid choice!\n";
+            return;
+        }
+        cout << "Tax policy set to " << taxPolicyName() << endl;
+    }
+
+    Employee* findEmployee(const string& id) {
+        auto it = idIndex.find(id);
+        return it == idIndex.end() ? nullptr : employees[it->second].get();
+    }
+
+    const Roster& getEmployees() const {
+        return employees;
+    }
+
+    const HotColumn& getHotRecords() const {
+        return hot;
     }
 
     int getEmployeeCount() {
@@ -854,19 +2643,1823 @@ public:
     }
 };
 
-// ================= MAIN =================
+// ================= QUERY SERVER =================
 
-int main() {
-    Company company("TechCorp Solutions");
+#ifdef __linux__
 
-    cout << "========================================\n";
-    cout << "   EMPLOYEE MANAGEMENT SYSTEM\n";
-    cout << "========================================\n\n";
+// Set from SIGINT/SIGTERM; the event loop polls it between waits
+static volatile sig_atomic_t serverStopRequested = 0;
+
+static void onServerSignal(int) {
+    serverStopRequested = 1;
+}
+
+// Serves the Company over a Unix domain socket.
+//
+// Protocol: one request per line. Every response starts with either
+//   OK <n>        followed by exactly n result lines, or
+//   ERR <message>
+// Employee result lines are  ID|Name|Type|Department|Pay
+//
+//   GET <id>              NAME <text>           DEPT <department>
+//   STATS                 TOP <n>               PAYROLL
+//   RAISE <id> <pct>      PROJECT <id>          HOURS <id> <hours>
+//   LEAVE <id> <days>     COMPLETE <id>         REVIEW <id> <1-5> <text>
+//
+// One thread runs the epoll loop; connections are armed EPOLLONESHOT and
+// handed to the worker pool, so each connection is served by at most one
+// worker at a time and its responses stay in request order. Reads share
+// the company lock; mutations take it exclusively.
+class QueryServer {
+private:
+    static const size_t MAX_REQUEST = 4096; // longest request line accepted
+
+    Company& company;
+    string socketPath;
+    int workerCount;
+    int listenFd;
+    int epollFd;
+    shared_mutex companyLock;
+
+    mutex connectionsLock;
+    unordered_map<int, string> pendingInput; // fd -> bytes not yet a full line
+
+    mutex queueLock;
+    condition_variable queueReady;
+    deque<int> readyConnections;
+    bool stopping;
+
+    static string describe(Employee* emp) {
+        ostringstream out;
+        out << emp->getID() << "|" << emp->getName() << "|" << emp->getEmployeeType()
+            << "|" << emp->getDepartment() << "|" << fixed << setprecision(2)
+            << emp->calculatePay() << "\n";
+        return out.str();
+    }
+
+    static string ok(const vector<string>& lines) {
+        string out = "OK " + to_string(lines.size()) + "\n";
+        for (const auto& line : lines) out += line;
+        return out;
+    }
+
+    static string error(const string& message) {
+        return "ERR " + message + "\n";
+    }
+
+    string handleQuery(const string& command, stringstream& args) {
+        shared_lock<shared_mutex> lock(companyLock);
+        const auto& roster = company.getEmployees();
+        const HotColumn& hot = company.getHotRecords();
+        vector<string> lines;
+
+        if (command == "GET") {
+            string id;
+            args >> id;
+            Employee* emp = company.findEmployee(id);
+            if (!emp) return error("not found");
+            lines.push_back(describe(emp));
+        }
+        else if (command == "NAME") {
+            string text;
+            getline(args >> ws, text);
+            for (auto& emp : roster) {
+                if (emp->getName().find(text) != string::npos) {
+                    lines.push_back(describe(emp.get()));
+                }
+            }
+        }
+        else if (command == "DEPT") {
+            string text;
+            getline(args >> ws, text);
+            int code = departmentSymbols.find(text);
+            for (size_t e = 0; e < roster.size(); e++) {
+                if (hot[e].departmentCode == code) {
+                    lines.push_back(describe(roster[e].get()));
+                }
+            }
+        }
+        else if (command == "STATS") {
+            vector<int> count(departmentSymbols.size(), 0);
+            vector<float> payroll(departmentSymbols.size(), 0);
+            for (const HotRecord& h : hot) {
+                count[h.departmentCode]++;
+                payroll[h.departmentCode] += h.pay();
+            }
+            for (int dept : departmentSymbols.sortedCodes()) {
+                if (count[dept] == 0) continue;
+                ostringstream out;
+                out << departmentSymbols.name(dept) << "|" << count[dept] << "|"
+                    << fixed << setprecision(2) << payroll[dept] << "\n";
+                lines.push_back(out.str());
+            }
+        }
+        else if (command == "TOP") {
+            int n = 10;
+            args >> n;
+            vector<pair<float, Employee*>> earnings;
+            earnings.reserve(roster.size());
+            for (size_t e = 0; e < roster.size(); e++) {
+                earnings.push_back({hot[e].pay(), roster[e].get()});
+            }
+            n = max(0, min(n, (int)earnings.size()));
+            partial_sort(earnings.begin(), earnings.begin() + n, earnings.end(),
+                         [](const pair<float, Employee*>& a, const pair<float, Employee*>& b) {
+                             return a.first > b.first;
+                         });
+            for (int i = 0; i < n; i++) {
+                lines.push_back(describe(earnings[i].second));
+            }
+        }
+        else if (command == "PAYROLL") {
+            float total = 0;
+            for (const HotRecord& h : hot) {
+                total += h.pay();
+            }
+            ostringstream out;
+            out << roster.size() << "|" << fixed << setprecision(2) << total << "\n";
+            lines.push_back(out.str());
+        }
+        else {
+            return error("unknown command " + command);
+        }
+        return ok(lines);
+    }
+
+    string handleMutation(const string& command, stringstream& args) {
+        unique_lock<shared_mutex> lock(companyLock);
+        string id;
+        args >> id;
+        Employee* emp = company.findEmployee(id);
+        if (!emp) return error("not found");
+
+        if (command == "RAISE") {
+            float percentage;
+            if (!(args >> percentage)) return error("usage: RAISE <id> <pct>");
+            if (!(percentage > -100)) return error("raise percentage must be greater than -100");
+            FullTimeEmployee* fte = dynamic_cast<FullTimeEmployee*>(emp);
+            if (!fte) return error("not a full-time employee");
+            fte->applyRaise(percentage);
+        }
+        else if (command == "PROJECT") {
+            Developer* dev = dynamic_cast<Developer*>(emp);
+            if (!dev) return error("not a developer");
+            dev->recordProject();
+        }
+        else if (command == "HOURS") {
+            int hours;
+            if (!(args >> hours)) return error("usage: HOURS <id> <hours>");
+            if (hours <= 0) return error("hours must be positive");
+            PartTimeEmployee* pte = dynamic_cast<PartTimeEmployee*>(emp);
+            if (!pte) return error("not part-time");
+            pte->addHours(hours);
+        }
+        else if (command == "LEAVE") {
+            int days;
+            if (!(args >> days)) return error("usage: LEAVE <id> <days>");
+            if (days <= 0) return error("days must be positive");
+            if (!emp->applyLeave(days)) return error("insufficient leave balance");
+        }
+        else if (command == "COMPLETE") {
+            ContractEmployee* ce = dynamic_cast<ContractEmployee*>(emp);
+            if (!ce) return error("not a contract employee");
+            ce->markCompleted();
+        }
+        else if (command == "REVIEW") {
+            int rating;
+            string review;
+            if (!(args >> rating) || rating < 1 || rating > 5) {
+                return error("usage: REVIEW <id> <1-5> <text>");
+            }
+            getline(args >> ws, review);
+            emp->addPerformanceReview(rating, review, "", "query server");
+        }
+        return ok({describe(emp)});
+    }
+
+    string handleRequest(const string& line) {
+        stringstream args(line);
+        string command;
+        args >> command;
+        if (command.empty()) return error("empty request");
+
+        if (command == "RAISE" || command == "PROJECT" || command == "HOURS" ||
+            command == "LEAVE" || command == "COMPLETE" || command == "REVIEW") {
+            return handleMutation(command, args);
+        }
+        return handleQuery(command, args);
+    }
+
+    static bool writeAll(int fd, const string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+            if (n > 0) {
+                sent += n;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd pfd = {fd, POLLOUT, 0};
+                if (poll(&pfd, 1, 1000) <= 0) return false;
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void closeConnection(int fd) {
+        {
+            lock_guard<mutex> lock(connectionsLock);
+            pendingInput.erase(fd);
+        }
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+    }
+
+    // Drains the socket, answers every complete line, then re-arms it
+    void serviceConnection(int fd) {
+        string* input;
+        {
+            lock_guard<mutex> lock(connectionsLock);
+            input = &pendingInput[fd];
+        }
+
+        // Complete lines are answered as they arrive, so only a partial
+        // line is ever buffered; one longer than MAX_REQUEST is refused
+        // and the connection dropped
+        bool closed = false;
+        string output;
+        char buffer[4096];
+        while (true) {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                input->append(buffer, n);
+                size_t start = 0, end;
+                while ((end = input->find('\n', start)) != string::npos) {
+                    string line = input->substr(start, end - start);
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    output += line.size() > MAX_REQUEST ? error("request too long")
+                                                        : handleRequest(line);
+                    start = end + 1;
+                }
+                input->erase(0, start);
+                if (input->size() > MAX_REQUEST) {
+                    output += error("request too long");
+                    closed = true;
+                    break;
+                }
+            } else if (n == 0) {
+                closed = true;
+                break;
+            } else if (errno == EINTR) {
+                continue;
+            } else {
+                closed = errno != EAGAIN && errno != EWOULDBLOCK;
+                break;
+            }
+        }
+
+        if (!output.empty() && !writeAll(fd, output)) closed = true;
+
+        if (closed) {
+            closeConnection(fd);
+        } else {
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+    }
+
+    void workerLoop() {
+        while (true) {
+            int fd;
+            {
+                unique_lock<mutex> lock(queueLock);
+                queueReady.wait(lock, [this] { return stopping || !readyConnections.empty(); });
+                if (stopping && readyConnections.empty()) return;
+                fd = readyConnections.front();
+                readyConnections.pop_front();
+            }
+            serviceConnection(fd);
+        }
+    }
+
+    void acceptConnections() {
+        while (true) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;
+            {
+                lock_guard<mutex> lock(connectionsLock);
+                pendingInput[fd].clear();
+            }
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        }
+    }
+
+public:
+    QueryServer(Company& c, string path, int workers)
+        : company(c), socketPath(path), workerCount(workers),
+          listenFd(-1), epollFd(-1), stopping(false) {}
+
+    ~QueryServer() {
+        if (epollFd >= 0) close(epollFd);
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(socketPath.c_str());
+        }
+    }
 
-    string filename = "employees.txt";
-    cout << "Loading employees from '" << filename << "'...\n\n";
+    bool start() {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(addr.sun_path)) {
+            cout << "Error: socket path too long\n";
+            return false;
+        }
+        strcpy(addr.sun_path, socketPath.c_str());
+        unlink(socketPath.c_str());
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0 ||
+            bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 ||
+            listen(listenFd, SOMAXCONN) < 0) {
+            cout << "Error: could not listen on " << socketPath << ": " << strerror(errno) << endl;
+            return false;
+        }
+
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) < 0) {
+            cout << "Error: epoll setup failed: " << strerror(errno) << endl;
+            return false;
+        }
+        return true;
+    }
+
+    void run() {
+        signal(SIGINT, onServerSignal);
+        signal(SIGTERM, onServerSignal);
+        signal(SIGPIPE, SIG_IGN);
+
+        vector<thread> workers;
+        for (int i = 0; i < workerCount; i++) {
+            workers.emplace_back(&QueryServer::workerLoop, this);
+        }
+
+        cout << "Serving " << company.getEmployeeCount() << " employees on "
+             << socketPath << " with " << workerCount << " workers\n";
+
+        epoll_event events[64];
+        while (!serverStopRequested) {
+            int n = epoll_wait(epollFd, events, 64, 500);
+            for (int i = 0; i < n; i++) {
+                if (events[i].data.fd == listenFd) {
+                    acceptConnections();
+                } else {
+                    lock_guard<mutex> lock(queueLock);
+                    readyConnections.push_back(events[i].data.fd);
+                    queueReady.notify_one();
+                }
+            }
+        }
+
+        {
+            lock_guard<mutex> lock(queueLock);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto& worker : workers) worker.join();
+
+        for (auto& entry : pendingInput) close(entry.first);
+        pendingInput.clear();
+        cout << "Server stopped.\n";
+    }
+};
+
+// ================= LOAD GENERATOR =================
+
+static int connectToServer(const string& path) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Blocking line reader over a socket with a carry-over buffer
+static bool readLine(int fd, string& buffer, string& line) {
+    size_t end;
+    while ((end = buffer.find('\n')) == string::npos) {
+        char chunk[4096];
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) return false;
+        buffer.append(chunk, n);
+    }
+    line = buffer.substr(0, end);
+    buffer.erase(0, end + 1);
+    return true;
+}
+
+// Sends one request and reads its full response; result lines are returned
+static bool serverRequest(int fd, string& buffer, const string& request, vector<string>* lines) {
+    string message = request + "\n";
+    if (write(fd, message.data(), message.size()) != (ssize_t)message.size()) return false;
+
+    string header;
+    if (!readLine(fd, buffer, header)) return false;
+    if (header.compare(0, 3, "OK ") != 0) return true;
+
+    int count = atoi(header.c_str() + 3);
+    string line;
+    for (int i = 0; i < count; i++) {
+        if (!readLine(fd, buffer, line)) return false;
+        if (lines) lines->push_back(line);
+    }
+    return true;
+}
+
+// Opens `connections` clients that each send `requests` requests back to
+// back (90% GET, the rest TOP/STATS/PAYROLL and a few LEAVE mutations)
+int runLoadGenerator(const string& path, int connections, int requests) {
+    signal(SIGPIPE, SIG_IGN);
+
+    int fd = connectToServer(path);
+    if (fd < 0) {
+        cout << "Error: could not connect to " << path << endl;
+        return 1;
+    }
+    string buffer;
+    vector<string> top;
+    serverRequest(fd, buffer, "TOP 1000", &top);
+    close(fd);
+
+    vector<string> ids;
+    for (const auto& line : top) {
+        ids.push_back(line.substr(0, line.find('|')));
+    }
+    if (ids.empty()) {
+        cout << "Error: server returned no employees\n";
+        return 1;
+    }
+
+    vector<vector<double>> latencies(connections);
+    atomic<int> failures(0);
+    vector<thread> clients;
+
+    auto start = Clock::now();
+    for (int c = 0; c < connections; c++) {
+        clients.emplace_back([&, c] {
+            int sock = connectToServer(path);
+            if (sock < 0) {
+                failures++;
+                return;
+            }
+            string carry;
+            mt19937 rng(c + 1);
+            latencies[c].reserve(requests);
+            for (int i = 0; i < requests; i++) {
+                int roll = rng() % 100;
+                string id = ids[rng() % ids.size()];
+                string request;
+                if (roll < 90) request = "GET " + id;
+                else if (roll < 95) request = "TOP 10";
+                else if (roll < 97) request = "STATS";
+                else if (roll < 99) request = "PAYROLL";
+                else request = "LEAVE " + id + " 0";
+
+                auto sent = Clock::now();
+                if (!serverRequest(sock, carry, request, nullptr)) {
+                    failures++;
+                    break;
+                }
+                latencies[c].push_back(elapsedMs(sent));
+            }
+            close(sock);
+        });
+    }
+    for (auto& client : clients) client.join();
+    double wallMs = elapsedMs(start);
+
+    vector<double> all;
+    for (auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+    if (all.empty()) {
+        cout << "Error: no requests completed\n";
+        return 1;
+    }
+    sort(all.begin(), all.end());
+    auto percentile = [&all](double p) { return all[(size_t)(p * (all.size() - 1))]; };
+
+    cout << fixed << setprecision(3);
+    cout << "loadgen: " << connections << " connections x " << requests << " requests\n";
+    cout << "  completed : " << all.size() << " (" << failures << " failures)\n";
+    cout << "  QPS       : " << setprecision(0) << all.size() / (wallMs / 1000) << endl;
+    cout << setprecision(3);
+    cout << "  p50       : " << percentile(0.50) << " ms\n";
+    cout << "  p99       : " << percentile(0.99) << " ms\n";
+    cout << "  max       : " << all.back() << " ms\n";
+    return failures == 0 ? 0 : 1;
+}
+
+#endif
+
+// ================= BENCHMARKS =================
+
+// Year-end run: batched engine vs one calculatePay() pass per period
+void benchPayrollPeriods(Company& company, int periods) {
+    const auto& roster = company.getEmployees();
+
+    auto start = Clock::now();
+    double sequential = 0;
+    for (int p = 0; p < periods; p++) {
+        for (auto& emp : roster) {
+            sequential += emp->calculatePay();
+        }
+    }
+    double sequentialMs = elapsedMs(start);
+
+    start = Clock::now();
+    PayrollPeriodEngine engine(company.getHotRecords(), periods);
+    const HotColumn& hot = company.getHotRecords();
+    for (size_t e = 0; e < hot.size(); e++) {
+        for (int p = 0; p < periods; p++) engine.addHours(p, e, hot[e].hours);
+    }
+    double buildMs = elapsedMs(start);
+    start = Clock::now();
+    engine.run();
+    double runMs = elapsedMs(start);
+
+    cout << fixed << setprecision(2);
+    cout << "payroll-periods: " << roster.size() << " employees x " << periods << " periods\n";
+    cout << "  sequential passes : " << sequentialMs << " ms (total $" << sequential << ")\n";
+    cout << "  engine build      : " << buildMs << " ms\n";
+    cout << "  engine run        : " << runMs << " ms (total $" << engine.getTotalGross() << ")\n";
+}
+
+// Batch tax per policy against the old per-employee flat multiply
+void benchTax(Company& company) {
+    const auto& roster = company.getEmployees();
+    size_t n = roster.size();
+    vector<float> gross(n), tax(n);
+    vector<unsigned char> kind(n);
+    for (size_t i = 0; i < n; i++) {
+        gross[i] = roster[i]->calculatePay();
+        kind[i] = roster[i]->getKind();
+    }
+
+    const int rounds = 20;
+    auto start = Clock::now();
+    double flatSum = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < n; i++) {
+            tax[i] = gross[i] * 0.10f;
+        }
+        flatSum += tax[r % n];
+    }
+    double multiplyMs = elapsedMs(start) / rounds;
+
+    TaxPolicyId saved = activeTaxPolicy;
+    cout << fixed << setprecision(3);
+    cout << "tax: " << n << " employees, mean of " << rounds << " rounds\n";
+    cout << "  flat multiply     : " << multiplyMs << " ms (checksum " << flatSum << ")\n";
+    for (TaxPolicyId id : {TAX_FLAT, TAX_PROGRESSIVE}) {
+        activeTaxPolicy = id;
+        start = Clock::now();
+        double sum = 0;
+        for (int r = 0; r < rounds; r++) {
+            computeTaxBatch(gross.data(), kind.data(), tax.data(), n);
+            sum += tax[r % n];
+        }
+        cout << "  " << left << setw(18) << taxPolicyName() << right << ": "
+             << elapsedMs(start) / rounds << " ms (checksum " << sum << ")\n";
+    }
+    activeTaxPolicy = saved;
+}
+
+// Nightly delta: 1% renamed, 0.5% dropped, 1% new hires; vs full reload
+void benchReconcile(int count) {
+    stringstream original;
+    generateRoster(original, count, 42);
+    string originalText = original.str();
+
+    stringstream updated, source(originalText);
+    string line;
+    int record = 0;
+    while (getline(source, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        record++;
+        if (record % 200 == 0) continue;
+        if (record % 100 == 1) {
+            size_t nameEnd = line.find('|', line.find('|') + 1);
+            line.insert(nameEnd, " Jr");
+        }
+        updated << line << "\n";
+    }
+    generateRoster(updated, count / 100, 7, count);
+    string updatedText = updated.str();
+
+    Company live("Benchmark Corp");
+    stringstream liveInput(originalText);
+    live.loadFromStream(liveInput);
+
+    auto start = Clock::now();
+    stringstream reconcileInput(updatedText);
+    Company::ReconcileSummary summary = live.reconcileFromStream(reconcileInput);
+    double reconcileMs = elapsedMs(start);
+
+    start = Clock::now();
+    Company reloaded("Benchmark Corp");
+    stringstream reloadInput(updatedText);
+    reloaded.loadFromStream(reloadInput);
+    double reloadMs = elapsedMs(start);
+
+    cout << fixed << setprecision(2);
+    cout << "reconcile: " << count << " employees (+" << summary.added
+         << " -" << summary.removed << " ~" << summary.changed << ")\n";
+    cout << "  reconcile         : " << reconcileMs << " ms\n";
+    cout << "  full reload       : " << reloadMs << " ms\n";
+    cout << "  employees         : " << live.getEmployeeCount()
+         << " live, " << reloaded.getEmployeeCount() << " reloaded\n";
+}
+
+// Department grouping by interned code vs the old string-keyed map, and
+// the memory the interned fields would take as separate strings
+void benchSymbols(Company& company) {
+    const auto& roster = company.getEmployees();
+    const int rounds = 10;
+
+    auto start = Clock::now();
+    size_t groups = 0;
+    for (int r = 0; r < rounds; r++) {
+        map<string, int> deptCount;
+        map<string, float> deptPayroll;
+        for (auto& emp : roster) {
+            string dept = emp->getDepartment();
+            deptCount[dept]++;
+            deptPayroll[dept] += emp->calculatePay();
+        }
+        groups = deptCount.size();
+    }
+    double stringMs = elapsedMs(start) / rounds;
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        vector<int> deptCount(departmentSymbols.size(), 0);
+        vector<float> deptPayroll(departmentSymbols.size(), 0);
+        for (auto& emp : roster) {
+            int dept = emp->getDepartmentCode();
+            deptCount[dept]++;
+            deptPayroll[dept] += emp->calculatePay();
+        }
+    }
+    double codeMs = elapsedMs(start) / rounds;
+
+    auto stringBytes = [](const string& str) { return sizeof(string) + stringHeap(str); };
+    size_t asStrings = 0, asCodes = 0;
+    for (auto& emp : roster) {
+        asStrings += stringBytes(emp->getDepartment());
+        asCodes += sizeof(int);
+        if (Developer* dev = dynamic_cast<Developer*>(emp.get())) {
+            asStrings += stringBytes(dev->getLanguage());
+            asCodes += sizeof(int);
+        }
+        if (Intern* in = dynamic_cast<Intern*>(emp.get())) {
+            asStrings += stringBytes(in->getUniversity()) + stringBytes(in->getMentor());
+            asCodes += 2 * sizeof(int);
+        }
+    }
+    size_t tables = departmentSymbols.memoryUsage() + languageSymbols.memoryUsage()
+                    + universitySymbols.memoryUsage() + mentorSymbols.memoryUsage();
+
+    cout << fixed << setprecision(2);
+    cout << "symbols: " << roster.size() << " employees, " << groups << " departments\n";
+    cout << "  group by string   : " << stringMs << " ms\n";
+    cout << "  group by code     : " << codeMs << " ms\n";
+    cout << "  fields as strings : " << asStrings / 1024.0 / 1024.0 << " MB\n";
+    cout << "  fields as codes   : " << asCodes / 1024.0 / 1024.0 << " MB + "
+         << tables / 1024.0 / 1024.0 << " MB symbol tables\n";
+}
+
+// Annual raise cycle: one bulkRaise vs an ID lookup + raise per employee
+void benchBulkRaise(Company& company) {
+    vector<string> ids;
+    for (auto& emp : company.getEmployees()) {
+        if (Company::isFullTime(emp.get())) ids.push_back(emp->getID());
+    }
+
+    auto start = Clock::now();
+    for (const auto& id : ids) {
+        FullTimeEmployee* fte = dynamic_cast<FullTimeEmployee*>(company.findEmployee(id));
+        if (fte) fte->applyRaise(3);
+    }
+    double singleMs = elapsedMs(start);
+
+    start = Clock::now();
+    Company::BatchResult result = company.bulkRaise(3, "", 0);
+    double batchMs = elapsedMs(start);
+
+    start = Clock::now();
+    Company::BatchResult rejected = company.bulkRaise(-150, "", 0);
+    double rejectMs = elapsedMs(start);
+
+    cout << fixed << setprecision(2);
+    cout << "bulk-raise: " << ids.size() << " full-time employees\n";
+    cout << "  one at a time     : " << singleMs << " ms\n";
+    cout << "  bulkRaise         : " << batchMs << " ms (" << result.affected << " updated)\n";
+    cout << "  rejected batch    : " << rejectMs << " ms (" << rejected.errors.size() << " errors)\n";
+}
+
+// Random tree over the roster: build the CSR chart and roll up every node
+void benchOrgChart(Company& company) {
+    const auto& roster = company.getEmployees();
+    size_t n = roster.size();
+    mt19937 rng(42);
+    vector<int> parentOf(n, -1);
+    vector<float> pay(n), rating(n, 0);
+    for (size_t e = 0; e < n; e++) {
+        if (e > 0) parentOf[e] = rng() % e;
+        pay[e] = roster[e]->calculatePay();
+        rating[e] = 1 + rng() % 5;
+    }
+
+    auto start = Clock::now();
+    OrgChart chart(move(parentOf));
+    double buildMs = elapsedMs(start);
+
+    start = Clock::now();
+    chart.rollup(pay, rating);
+    double rollupMs = elapsedMs(start);
+
+    start = Clock::now();
+    double checksum = 0;
+    for (size_t v = 0; v < n; v++) {
+        checksum += chart.headcount(v) + chart.teamPayroll(v) + chart.averageRating(v);
+    }
+    double queryMs = elapsedMs(start);
+
+    cout << fixed << setprecision(2);
+    cout << "org-chart: " << n << " nodes, deepest chain "
+         << chart.deepestChain(0).size() - 1 << " levels\n";
+    cout << "  build structure   : " << buildMs << " ms\n";
+    cout << "  rollup all nodes  : " << rollupMs << " ms\n";
+    cout << "  query every node  : " << queryMs << " ms (checksum " << checksum << ")\n";
+}
+
+// One payroll pass through the employee objects vs one over the hot
+// column, each starting from a cache emptied by streaming a large buffer
+void benchHotCold(Company& company) {
+    const auto& roster = company.getEmployees();
+    const HotColumn& hot = company.getHotRecords();
+    vector<char> evict(256 << 20);
+    auto flushCaches = [&evict]() {
+        for (size_t i = 0; i < evict.size(); i += 64) evict[i]++;
+    };
+
+    const int rounds = 5;
+    double objectMs = 0, hotMs = 0, objectTotal = 0, hotTotal = 0;
+    for (int r = 0; r < rounds; r++) {
+        flushCaches();
+        auto start = Clock::now();
+        for (auto& emp : roster) {
+            objectTotal += emp->calculatePay();
+        }
+        objectMs += elapsedMs(start);
+
+        flushCaches();
+        start = Clock::now();
+        for (const HotRecord& h : hot) {
+            hotTotal += h.pay();
+        }
+        hotMs += elapsedMs(start);
+    }
+
+    double n = max<size_t>(roster.size(), 1);
+    cout << fixed << setprecision(2);
+    cout << "hot-cold: " << roster.size() << " employees, cold cache, " << rounds << " rounds\n";
+    cout << "  object sizes      : Manager " << sizeof(Manager) << ", Developer " << sizeof(Developer)
+         << ", PartTime " << sizeof(PartTimeEmployee) << ", Contract " << sizeof(ContractEmployee)
+         << " bytes; hot record " << sizeof(HotRecord) << " bytes\n";
+    cout << "  through objects   : " << objectMs / rounds << " ms ("
+         << objectMs / rounds * 1e6 / n << " ns/employee, total $" << objectTotal / rounds << ")\n";
+    cout << "  hot column        : " << hotMs / rounds << " ms ("
+         << hotMs / rounds * 1e6 / n << " ns/employee, total $" << hotTotal / rounds << ")\n";
+}
+
+// Heap bytes currently in use, where the C library can report it
+static size_t heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+// Eager vs lazy load of the same roster file
+void benchLazyLoad(int count) {
+    const string filename = "bench_roster.tmp";
+    {
+        ofstream out(filename);
+        generateRoster(out, count, 42);
+    }
+
+    cout << fixed << setprecision(2);
+    cout << "lazy-load: " << count << " employees\n";
+    for (bool lazy : {false, true}) {
+        size_t heapBefore = heapInUse();
+        auto start = Clock::now();
+        Company company("Benchmark Corp");
+        company.loadFromFile(filename, lazy);
+        double loadMs = elapsedMs(start);
+        size_t heapBytes = heapInUse() - heapBefore;
+
+        start = Clock::now();
+        size_t touched = 0;
+        for (auto& emp : company.getEmployees()) {
+            touched += emp->getAddress().size() + emp->getJoinDate().size();
+        }
+        double coldMs = elapsedMs(start);
+
+        cout << "  " << (lazy ? "lazy " : "eager") << "  load " << loadMs << " ms, heap "
+             << heapBytes / 1024.0 / 1024.0 << " MB, read all cold fields "
+             << coldMs << " ms (" << touched << " bytes)\n";
+    }
+    remove(filename.c_str());
+}
+
+int runBenchmark(const string& name, int count) {
+    Company company("Benchmark Corp");
+    stringstream roster;
+    generateRoster(roster, count, 42);
+
+    auto start = Clock::now();
+    company.loadFromStream(roster);
+    cout << fixed << setprecision(2);
+    cout << "load: " << company.getEmployeeCount() << " employees in "
+         << elapsedMs(start) << " ms\n";
+
+    bool all = name == "all";
+    bool known = false;
+    if (all || name == "payroll-periods") {
+        benchPayrollPeriods(company, 12);
+        known = true;
+    }
+    if (all || name == "tax") {
+        benchTax(company);
+        known = true;
+    }
+    if (all || name == "symbols") {
+        benchSymbols(company);
+        known = true;
+    }
+    if (all || name == "bulk-raise") {
+        benchBulkRaise(company);
+        known = true;
+    }
+    if (all || name == "org-chart") {
+        benchOrgChart(company);
+        known = true;
+    }
+    if (all || name == "hot-cold") {
+        benchHotCold(company);
+        known = true;
+    }
+    if (all || name == "lazy-load") {
+        benchLazyLoad(count);
+        known = true;
+    }
+    if (all || name == "reconcile") {
+        benchReconcile(count);
+        known = true;
+    }
+    if (!known) {
+        cout << "Unknown benchmark: " << name << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// ================= MEMORY REPORT =================
+
+static size_t employeeObjectSize(EmployeeKind kind) {
+    switch (kind) {
+        case KIND_MANAGER: return sizeof(Manager);
+        case KIND_DEVELOPER: return sizeof(Developer);
+        case KIND_PARTTIME: return sizeof(PartTimeEmployee);
+        case KIND_INTERN: return sizeof(Intern);
+        case KIND_CONTRACT: return sizeof(ContractEmployee);
+        default: return sizeof(FullTimeEmployee);
+    }
+}
+
+// Runs one operation with its console output discarded and reports what
+// it allocated in each tracked subsystem. Retained is what the subsystem
+// still holds afterwards beyond what it held before; peak transient is the
+// most it held at once above what it ended up holding.
+template <class Operation>
+void reportAllocations(const string& label, Operation op) {
+    size_t allocations[MEM_SUBSYSTEMS], bytes[MEM_SUBSYSTEMS], live[MEM_SUBSYSTEMS];
+    for (int m = 0; m < MEM_SUBSYSTEMS; m++) {
+        memCounters[m].resetPeak();
+        allocations[m] = memCounters[m].allocations;
+        bytes[m] = memCounters[m].bytes;
+        live[m] = memCounters[m].live;
+    }
+    size_t heapBefore = heapInUse();
+
+    // Discarded writes leave widths and flags unconsumed; put them back
+    ios format(nullptr);
+    format.copyfmt(cout);
+    streambuf* saved = cout.rdbuf(nullptr);
+    auto start = Clock::now();
+    op();
+    double ms = elapsedMs(start);
+    cout.rdbuf(saved);
+    cout.clear();
+    cout.copyfmt(format);
+
+    cout << "  " << label << " (" << ms << " ms, heap "
+         << ((double)heapInUse() - heapBefore) / 1024 << " KB)\n";
+    for (int m = 0; m < MEM_SUBSYSTEMS; m++) {
+        size_t count = memCounters[m].allocations - allocations[m];
+        if (count == 0) continue;
+        size_t liveAfter = memCounters[m].live;
+        cout << "    " << left << setw(18) << memSubsystemNames[m] << right
+             << setw(9) << count << " allocations, "
+             << setw(10) << (memCounters[m].bytes - bytes[m]) / 1024.0 << " KB allocated, retained "
+             << setw(10) << ((double)liveAfter - live[m]) / 1024 << " KB, peak transient "
+             << setw(10) << (memCounters[m].peak - liveAfter) / 1024.0 << " KB\n";
+    }
+}
+
+// Footprint of a roster and the allocations of the main operations on it.
+// `source` is a roster file or an employee count to generate.
+int runMemoryReport(const string& source) {
+    Company company("Memory Corp");
+    cout << fixed << setprecision(2);
+    cout << "memory: " << source << "\n";
+    cout << "allocations per operation:\n";
+
+    bool generated = !source.empty() && source.find_first_not_of("0123456789") == string::npos;
+    size_t heapBefore = heapInUse();
+    bool loaded = true;
+    if (generated) {
+        stringstream roster;
+        generateRoster(roster, atoi(source.c_str()), 42);
+        reportAllocations("load", [&]() { company.loadFromStream(roster); });
+    } else {
+        reportAllocations("load", [&]() { loaded = company.loadFromFile(source); });
+    }
+    size_t heapBytes = heapInUse() - heapBefore;
+    if (!loaded || company.getEmployeeCount() == 0) {
+        cout << "No employees loaded!\n";
+        return 1;
+    }
+
+    // Inline object, hot record and owned heap bytes, by employee type
+    const auto& roster = company.getEmployees();
+    size_t count[KIND_COUNT] = {}, objectBytes[KIND_COUNT] = {}, heapUsed[KIND_COUNT] = {};
+    for (auto& emp : roster) {
+        EmployeeKind kind = emp->getKind();
+        count[kind]++;
+        objectBytes[kind] += employeeObjectSize(kind);
+        heapUsed[kind] += emp->heapUsage();
+    }
+    double n = roster.size();
+    cout << "bytes per employee:\n";
+    cout << "  " << left << setw(20) << "Type" << right << setw(9) << "Count" << setw(9) << "Object"
+         << setw(9) << "Hot" << setw(9) << "Heap" << setw(9) << "Total" << "\n";
+    for (int k = 0; k < KIND_COUNT; k++) {
+        if (count[k] == 0) continue;
+        double object = (double)objectBytes[k] / count[k];
+        double heap = (double)heapUsed[k] / count[k];
+        cout << "  " << left << setw(20) << kindName(k) << right << setw(9) << count[k]
+             << setw(9) << object << setw(9) << sizeof(HotRecord) << setw(9) << heap
+             << setw(9) << object + sizeof(HotRecord) + heap << "\n";
+    }
+    cout << "  roster vector " << memCounters[MEM_ROSTER].live / n << ", id index "
+         << memCounters[MEM_ID_INDEX].live / n << " per employee\n";
+    if (heapBytes > 0) {
+        cout << "  malloc heap after load: " << heapBytes / n << " per employee ("
+             << heapBytes / 1024.0 / 1024.0 << " MB, allocator overhead included)\n";
+    }
+
+    cout << "allocations per query:\n";
+    reportAllocations("topEarners", [&]() { company.topEarners(); });
+    reportAllocations("showDepartmentStats", [&]() { company.showDepartmentStats(); });
+    reportAllocations("showEmployeesByExperience", [&]() { company.showEmployeesByExperience(); });
+    reportAllocations("review every employee", [&]() {
+        for (auto& emp : roster) emp->addPerformanceReview(4, "Solid quarter", "2025-03-31", "Auditor");
+    });
+    return 0;
+}
+
+// ================= PERF BASELINE =================
+
+// Machine-speed reference independent of the payroll code: sorting and
+// hashing a fixed data set. Reported next to the results so a failed
+// check on a slower or busier machine can be told from a regression.
+static double calibrationMs() {
+    mt19937 rng(1);
+    vector<uint32_t> numbers(1 << 20);
+    for (auto& n : numbers) n = rng();
+    vector<string> keys;
+    for (int i = 0; i < 100000; i++) keys.push_back("key-" + to_string(rng()));
+
+    auto start = Clock::now();
+    sort(numbers.begin(), numbers.end());
+    unordered_map<string, int> table;
+    for (const auto& key : keys) table[key]++;
+    double ms = elapsedMs(start);
+    if (table.empty() || numbers[0] > numbers.back()) cout << "perf: bad calibration\n";
+    return ms;
+}
+
+// Fixed workload for tracking performance across builds: load, payroll,
+// search and export on a generated roster. Each figure is the median of
+// several runs, which a single lucky or unlucky run cannot move.
+map<string, double> runPerfSuite(int count) {
+    const int runs = 7;
+    stringstream generated;
+    generateRoster(generated, count, 42);
+    const string text = generated.str();
+
+    auto median = [](vector<double> samples) {
+        nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        return samples[samples.size() / 2];
+    };
+
+    vector<double> calibration, load, payroll, searchID, searchName, exportMs;
+    for (int r = 0; r < runs; r++) {
+        for (int c = 0; c < 3; c++) calibration.push_back(calibrationMs());
+        Company company("Perf Corp");
+        stringstream input(text);
+        auto start = Clock::now();
+        company.loadFromStream(input);
+        load.push_back(elapsedMs(start));
+
+        start = Clock::now();
+        PayrollPeriodEngine engine(company.getHotRecords(), 12);
+        engine.run();
+        payroll.push_back(elapsedMs(start));
+
+        // Every ID once, in a shuffled order
+        const auto& roster = company.getEmployees();
+        vector<string> ids;
+        ids.reserve(roster.size());
+        for (auto& emp : roster) ids.push_back(emp->getID());
+        shuffle(ids.begin(), ids.end(), mt19937(7));
+        size_t found = 0;
+        start = Clock::now();
+        for (const string& id : ids) {
+            found += company.findEmployee(id) != nullptr;
+        }
+        searchID.push_back(elapsedMs(start));
+
+        // Substring name searches as in the menu's name search
+        static const char* names[] = { "Alice", "Smith", "Mia Chen", "Young", "Noah Ross" };
+        start = Clock::now();
+        for (const char* text : names) {
+            for (auto& emp : roster) {
+                found += emp->getName().find(text) != string::npos;
+            }
+        }
+        searchName.push_back(elapsedMs(start));
+
+        ostringstream report;
+        start = Clock::now();
+        company.writeReport(report);
+        exportMs.push_back(elapsedMs(start));
+        if (found == 0 || report.str().empty()) cout << "perf: empty workload\n";
+    }
+
+    return {
+        {"employees", count},
+        {"calibration_ms", median(calibration)},
+        {"load_ms", median(load)},
+        {"payroll_12_periods_ms", median(payroll)},
+        {"search_id_ms", median(searchID)},
+        {"search_name_ms", median(searchName)},
+        {"export_ms", median(exportMs)}
+    };
+}
+
+// Baselines are flat JSON objects of "name": number pairs
+bool writePerfJson(const string& filename, const map<string, double>& results) {
+    ofstream out(filename);
+    if (!out.is_open()) return false;
+    out << "{\n" << fixed << setprecision(3);
+    size_t i = 0;
+    for (const auto& entry : results) {
+        out << "  \"" << entry.first << "\": " << entry.second
+            << (++i < results.size() ? ",\n" : "\n");
+    }
+    out << "}\n";
+    return true;
+}
+
+map<string, double> readPerfJson(const string& filename) {
+    map<string, double> results;
+    ifstream in(filename);
+    string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    size_t pos = 0;
+    while ((pos = text.find('"', pos)) != string::npos) {
+        size_t end = text.find('"', pos + 1);
+        size_t colon = end == string::npos ? end : text.find(':', end);
+        if (colon == string::npos) break;
+        results[text.substr(pos + 1, end - pos - 1)] = strtod(text.c_str() + colon + 1, nullptr);
+        pos = text.find_first_of(",}", colon);
+    }
+    return results;
+}
+
+// Records a new baseline, or compares against the stored one and fails
+// when a timing is more than `threshold` percent slower. A figure over the
+// threshold is measured again, and only one that stays over it in every
+// attempt counts as a regression, so one noisy suite cannot fail the check.
+int runPerfBaseline(const string& filename, bool record, double threshold, int count) {
+    const int attempts = 3;
+    map<string, double> baseline;
+    if (!record) {
+        baseline = readPerfJson(filename);
+        if (baseline.empty()) {
+            cout << "No baseline in " << filename << "; record one first.\n";
+            return 1;
+        }
+        count = (int)baseline["employees"];
+    }
+
+    map<string, double> current = runPerfSuite(count);
+    if (record) {
+        if (!writePerfJson(filename, current)) {
+            cout << "Error creating file!\n";
+            return 1;
+        }
+        cout << "Baseline for " << count << " employees written to " << filename << "\n";
+        return 0;
+    }
+
+    cout << fixed << setprecision(2);
+    cout << "perf-baseline: " << count << " employees, threshold " << threshold << "%\n";
+    map<string, int> overCount; // attempts each figure was over the threshold
+    for (int attempt = 1; attempt <= attempts; attempt++) {
+        if (attempt > 1) {
+            cout << "Measuring again (attempt " << attempt << " of " << attempts << ")\n";
+            current = runPerfSuite(count);
+        }
+        if (baseline["calibration_ms"] > 0) {
+            double speed = (current["calibration_ms"] / baseline["calibration_ms"] - 1) * 100;
+            cout << "  calibration " << current["calibration_ms"] << " ms, baseline "
+                 << baseline["calibration_ms"] << " ms";
+            if (fabs(speed) > threshold) {
+                cout << "  (machine " << showpos << speed << noshowpos
+                     << "%: not the machine or load the baseline was recorded under)";
+            }
+            cout << "\n";
+        }
+
+        bool anyOver = false;
+        for (const auto& entry : current) {
+            if (entry.first == "employees" || entry.first == "calibration_ms") continue;
+            if (attempt > 1 && overCount[entry.first] < attempt - 1) continue;
+            auto base = baseline.find(entry.first);
+            if (base == baseline.end() || base->second <= 0) {
+                cout << "  " << left << setw(24) << entry.first << right << setw(10) << entry.second
+                     << " ms  (no baseline)\n";
+                continue;
+            }
+            double change = (entry.second / base->second - 1) * 100;
+            bool over = change > threshold;
+            if (over) {
+                overCount[entry.first]++;
+                anyOver = true;
+            }
+            cout << "  " << left << setw(24) << entry.first << right << setw(10) << entry.second
+                 << " ms  baseline " << setw(10) << base->second << " ms  "
+                 << showpos << change << noshowpos << "%"
+                 << (over ? (attempt == attempts ? "  REGRESSION" : "  over threshold") : "") << "\n";
+        }
+        if (!anyOver) return 0;
+    }
+
+    int regressions = 0;
+    for (const auto& entry : overCount) regressions += entry.second == attempts;
+    cout << regressions << " benchmark(s) regressed more than " << threshold
+         << "% in all " << attempts << " attempts\n";
+    return 1;
+}
+
+// ================= SELF CHECK =================
+
+// Differential checker: feeds the same rosters and mutations through the
+// reference per-employee class methods and through the optimized paths
+// (lazy loading, the period engine, batch tax, department codes, the ID
+// index, bulk mutations, reconcile and org chart rollups) and compares.
+class SelfCheck {
+private:
+    mt19937 rng;
+    int checks;
+    int failures;
+
+    // Pay inputs for the hourly and contract kinds, read from the roster
+    // text by hand so the reference pay never goes through the parser
+    struct ReferenceInputs {
+        float rate;
+        float hours;
+        float amount;
+        bool completed;
+    };
+    unordered_map<string, ReferenceInputs> referenceInputs;
+
+    void expect(bool ok, const string& what) {
+        checks++;
+        if (ok) return;
+        if (failures < 10) cout << "MISMATCH: " << what << endl;
+        failures++;
+    }
+
+    static bool close(double a, double b) {
+        return fabs(a - b) <= 1e-4 * max(1.0, max(fabs(a), fabs(b)));
+    }
+
+    // Generated roster with damaged copies of some of its lines mixed in.
+    // Damaged lines get fresh IDs, and the damage lands after the ID, so
+    // those still valid add employees instead of duplicating one.
+    string buildRoster(int count) {
+        stringstream generated;
+        generateRoster(generated, count, rng());
+        string text, line;
+        int damaged = 0;
+        while (getline(generated, line)) {
+            text += line + "\n";
+            if (line.empty() || line[0] == '#' || rng() % 50 != 0) continue;
+            size_t idStart = line.find(' ') + 2;
+            size_t idEnd = line.find(' ', idStart);
+            string id = "X" + to_string(damaged++);
+            string copy = line.substr(0, idStart) + id + line.substr(idEnd);
+            size_t afterID = idStart + id.size();
+            size_t at = afterID + rng() % (copy.size() - afterID);
+            switch (rng() % 4) {
+                case 0: copy.resize(at); break;
+                case 1: copy[at] = 'x'; break;
+                case 2: copy.erase(at, 1); break;
+                default: copy += " 7"; break;
+            }
+            text += copy + (rng() % 2 ? "\r\n" : "\n");
+        }
+        return text;
+    }
+
+    void checkLoads(const string& text, Company& eager) {
+        Company lazy("Lazy");
+        lazy.loadLazy(text);
+        const auto& a = eager.getEmployees();
+        const auto& b = lazy.getEmployees();
+        expect(a.size() == b.size(), "eager and lazy load sizes differ");
+        for (size_t i = 0; i < min(a.size(), b.size()); i++) {
+            Employee* x = a[i].get();
+            Employee* y = b[i].get();
+            string at = " at " + x->getID();
+            expect(x->getID() == y->getID(), "eager/lazy ID" + at);
+            expect(x->getKind() == y->getKind(), "eager/lazy type" + at);
+            expect(x->calculatePay() == y->calculatePay(), "eager/lazy pay" + at);
+            expect(x->getDepartmentCode() == y->getDepartmentCode(), "eager/lazy department" + at);
+            expect(x->getAddress() == y->getAddress(), "eager/lazy address" + at);
+            expect(x->getJoinDate() == y->getJoinDate(), "eager/lazy join date" + at);
+            if (x->getKind() == KIND_CONTRACT && y->getKind() == KIND_CONTRACT) {
+                expect(static_cast<ContractEmployee*>(x)->getContractEndDate()
+                           == static_cast<ContractEmployee*>(y)->getContractEndDate(),
+                       "eager/lazy contract end date" + at);
+            }
+            expect(x->getRecordHash() == y->getRecordHash(), "eager/lazy record hash" + at);
+        }
+
+        // Strict mode may only drop records, never change the ones it keeps
+        streambuf* saved = cout.rdbuf(nullptr);
+        Company strict("Strict");
+        stringstream input(text);
+        strict.loadFromStream(input, true);
+        cout.rdbuf(saved);
+        cout.clear();
+        for (auto& emp : strict.getEmployees()) {
+            Employee* match = eager.findEmployee(emp->getID());
+            expect(match && match->calculatePay() == emp->calculatePay(),
+                   "strict load kept a record the fast path parsed differently: " + emp->getID());
+        }
+    }
+
+    void readReferenceInputs(const string& text) {
+        referenceInputs.clear();
+        stringstream lines(text);
+        string line;
+        while (getline(lines, line)) {
+            stringstream head(line);
+            string type, id;
+            head >> type >> id;
+            // Damaged copies (X ids) are only there to exercise the loader
+            size_t bar = line.rfind('|');
+            if (id.empty() || id[0] == 'X' || bar == string::npos) continue;
+            stringstream tail(line.substr(bar + 1));
+            ReferenceInputs in = {0, 0, 0, false};
+            int completed = 0;
+            if (type == "PARTTIME") {
+                tail >> in.rate >> in.hours;
+            } else if (type == "INTERN") {
+                in.rate = 15.0f;
+                tail >> in.hours;
+            } else if (type == "CONTRACT") {
+                tail >> in.amount >> completed;
+                in.completed = completed == 1;
+            } else {
+                continue;
+            }
+            referenceInputs.emplace(id, in);
+        }
+    }
+
+    // Per-kind pay as the original calculatePay() overrides computed it,
+    // from the typed fields and the roster text rather than the hot record;
+    // returns false for records the reference cannot cover
+    bool referencePay(Employee* emp, float& pay) {
+        if (Company::isFullTime(emp)) {
+            FullTimeEmployee* fte = static_cast<FullTimeEmployee*>(emp);
+            pay = fte->getMonthlySalary() + fte->getBonus();
+            if (emp->getKind() == KIND_MANAGER) pay += 500 * static_cast<Manager*>(emp)->getTeamSize();
+            if (emp->getKind() == KIND_DEVELOPER) pay += static_cast<Developer*>(emp)->getProjectBonus();
+            return true;
+        }
+        auto found = referenceInputs.find(emp->getID());
+        if (found == referenceInputs.end()) return false;
+        const ReferenceInputs& in = found->second;
+        if (emp->getKind() == KIND_CONTRACT) {
+            pay = in.completed ? in.amount : in.amount * 0.5f;
+        } else {
+            pay = in.rate * in.hours;
+        }
+        return true;
+    }
+
+    void checkPay(Company& company) {
+        const auto& roster = company.getEmployees();
+        const int periods = 3;
+        // Every period repeats the roster's logged hours, so each period
+        // should pay what calculatePay() does; open contracts complete in
+        // a random period and are paid exactly once
+        const HotColumn& hot = company.getHotRecords();
+        PayrollPeriodEngine engine(hot, periods);
+        vector<int> completedIn(hot.size(), -1);
+        for (size_t e = 0; e < hot.size(); e++) {
+            for (int p = 0; p < periods; p++) engine.addHours(p, e, hot[e].hours);
+            if (hot[e].kind == KIND_CONTRACT && !hot[e].contractCompleted) {
+                completedIn[e] = rng() % periods;
+                expect(engine.completeContract(completedIn[e], e), "period engine refused an open contract");
+                expect(!engine.completeContract(periods - 1, e), "period engine paid a contract twice");
+            }
+        }
+        engine.run();
+        double reference = 0;
+        for (size_t e = 0; e < roster.size(); e++) {
+            Employee* emp = roster[e].get();
+            float pay = emp->calculatePay();
+            string at = " at " + emp->getID();
+            float expected;
+            if (referencePay(emp, expected)) {
+                expect(close(expected, pay), "reference pay" + at);
+            }
+            if (emp->getKind() == KIND_CONTRACT) {
+                auto found = referenceInputs.find(emp->getID());
+                float amount = found != referenceInputs.end() ? found->second.amount
+                                                             : emp->getPayComponents().contractAmount;
+                float paid = completedIn[e] >= 0 ? amount : 0;
+                expect(close(engine.getYtdGross(e), paid), "period engine contract payout" + at);
+                expect(close(engine.getYtdTax(e), emp->calculateTax(paid)
+                                                  + (periods - 1) * emp->calculateTax(0)),
+                       "period engine contract tax" + at);
+                reference += paid;
+                continue;
+            }
+            expect(close(engine.getYtdGross(e), periods * pay), "period engine gross" + at);
+            expect(close(engine.getYtdTax(e), periods * emp->calculateTax(pay)), "period engine tax" + at);
+            reference += periods * pay;
+        }
+        expect(close(engine.getTotalGross(), reference), "period engine total");
+    }
+
+    // A year of periods over one open and one finished contract: the open
+    // one is paid once, in the period its completion is reported, and the
+    // finished one not at all
+    void checkContractPayout() {
+        Company company("Contracts");
+        stringstream roster(
+            "CONTRACT C1 30 2 |Open Contract|1 Main St|Legal|2024-01-01|2024-12-31| 15000 0\n"
+            "CONTRACT C2 30 2 |Done Contract|1 Main St|Legal|2024-01-01|2024-06-30| 9000 1\n");
+        company.loadFromStream(roster);
+        expect(company.getEmployeeCount() == 2, "contract roster did not load");
+        if (company.getEmployeeCount() != 2) return;
+
+        streambuf* saved = cout.rdbuf(nullptr);
+        PayrollPeriodEngine engine(company.getHotRecords(), 12);
+        stringstream finished("C2 3 0 0 1\n"), twice("C1 2 0 0 1\nC1 5 0 0 1\n"), inputs("C1 5 0 0 1\n");
+        bool finishedAccepted = company.loadPeriodInputs(finished, engine);
+        bool twiceAccepted = company.loadPeriodInputs(twice, engine);
+        bool accepted = company.loadPeriodInputs(inputs, engine);
+        cout.rdbuf(saved);
+        cout.clear();
+        expect(!finishedAccepted, "period inputs completed a finished contract");
+        expect(!twiceAccepted, "period inputs completed a contract twice");
+        expect(accepted, "period inputs rejected a contract completion");
+
+        engine.run();
+        expect(engine.getYtdGross(0) == 15000, "12-period contract not paid exactly once");
+        expect(engine.getYtdGross(1) == 0, "12-period run paid a finished contract");
+        for (int p = 0; p < 12; p++) {
+            expect(engine.getPeriodGross(p) == (p == 4 ? 15000 : 0),
+                   "contract paid outside its completion period " + to_string(p + 1));
+        }
+    }
+
+    void checkTax(Company& company) {
+        const auto& roster = company.getEmployees();
+        size_t n = roster.size();
+        vector<float> gross(n), tax(n);
+        vector<unsigned char> kind(n);
+        for (size_t e = 0; e < n; e++) {
+            gross[e] = roster[e]->calculatePay();
+            kind[e] = roster[e]->getKind();
+        }
+        TaxPolicyId saved = activeTaxPolicy;
+        for (TaxPolicyId id : {TAX_FLAT, TAX_PROGRESSIVE}) {
+            activeTaxPolicy = id;
+            computeTaxBatch(gross.data(), kind.data(), tax.data(), n);
+            for (size_t e = 0; e < n; e++) {
+                expect(tax[e] == roster[e]->calculateTax(gross[e]),
+                       string("batch tax (") + taxPolicyName() + ") at " + roster[e]->getID());
+            }
+        }
+        activeTaxPolicy = saved;
+    }
+
+    void checkQueries(Company& company) {
+        const auto& roster = company.getEmployees();
+        map<string, pair<int, double>> byName;
+        vector<int> count(departmentSymbols.size(), 0);
+        vector<double> payroll(departmentSymbols.size(), 0);
+        for (auto& emp : roster) {
+            auto& entry = byName[emp->getDepartment()];
+            entry.first++;
+            entry.second += emp->calculatePay();
+            count[emp->getDepartmentCode()]++;
+            payroll[emp->getDepartmentCode()] += emp->calculatePay();
+        }
+        for (const auto& entry : byName) {
+            int code = departmentSymbols.find(entry.first);
+            expect(code >= 0 && count[code] == entry.second.first &&
+                   close(payroll[code], entry.second.second),
+                   "department grouping for " + entry.first);
+        }
+
+        vector<string> ids;
+        for (auto& emp : roster) ids.push_back(emp->getID());
+        ids.push_back("NOBODY");
+        ids.push_back("");
+        for (const string& id : ids) {
+            Employee* scanned = nullptr;
+            for (auto& emp : roster) {
+                if (emp->getID() == id) {
+                    scanned = emp.get();
+                    break;
+                }
+            }
+            expect(company.findEmployee(id) == scanned, "ID index lookup for '" + id + "'");
+        }
+    }
+
+    // One mutation sequence applied per employee to `reference` and as
+    // batches to `batched`; both companies start from the same roster
+    void checkMutations(Company& reference, Company& batched, int steps) {
+        static const char* departments[] = { "", "Engineering", "Sales", "HR", "Legal" };
+        const auto& roster = reference.getEmployees();
+        if (roster.empty()) return;
+
+        for (int step = 0; step < steps; step++) {
+            int op = rng() % 3;
+            if (op == 0) {
+                float pct = (int)(rng() % 30) - 5;
+                string dept = departments[rng() % 5];
+                float minRating = rng() % 2 ? 0 : 3;
+                if (!dept.empty() && departmentSymbols.find(dept) < 0) continue;
+                for (auto& emp : roster) {
+                    if (!Company::isFullTime(emp.get())) continue;
+                    if (!dept.empty() && emp->getDepartment() != dept) continue;
+                    if (minRating > 0 && emp->getAverageRating() < minRating) continue;
+                    static_cast<FullTimeEmployee*>(emp.get())->applyRaise(pct);
+                }
+                expect(batched.bulkRaise(pct, dept, minRating).committed, "bulk raise rejected");
+            } else if (op == 1) {
+                vector<pair<string, float>> table;
+                for (auto& emp : roster) {
+                    if (!Company::isFullTime(emp.get()) || rng() % 4 != 0) continue;
+                    float bonus = rng() % 2000;
+                    static_cast<FullTimeEmployee*>(emp.get())->setBonus(bonus);
+                    table.push_back({emp->getID(), bonus});
+                }
+                expect(batched.bulkSetBonus(table).committed, "bulk bonus rejected");
+            } else {
+                for (size_t i = 0; i < roster.size() / 10 + 1; i++) {
+                    Employee* emp = roster[rng() % roster.size()].get();
+                    int rating = 1 + rng() % 5;
+                    emp->addPerformanceReview(rating, "", "", "selfcheck");
+                    batched.findEmployee(emp->getID())->addPerformanceReview(rating, "", "", "selfcheck");
+                }
+            }
+        }
+
+        for (auto& emp : roster) {
+            Employee* twin = batched.findEmployee(emp->getID());
+            expect(twin && twin->calculatePay() == emp->calculatePay(),
+                   "bulk mutation pay at " + emp->getID());
+        }
+    }
+
+    // Reconcile onto `company` must leave the same roster a fresh load of
+    // the edited file would
+    void checkReconcile(Company& company, const string& text) {
+        stringstream input(text), edited;
+        string line;
+        int added = 0;
+        while (getline(input, line)) {
+            int roll = rng() % 100;
+            if (roll == 0) continue;                                      // dropped
+            if (roll == 1 && !line.empty() && line.back() != '\r') line += " 9"; // changed
+            edited << line << "\n";
+            if (roll == 2) edited << "PARTTIME R" << added++ << " 30 2 |New Hire|1 Main St|Sales|2024-01-15| 25.0 40\n";
+        }
+
+        stringstream again(edited.str());
+        company.reconcileFromStream(again);
+        Company fresh("Fresh");
+        stringstream reload(edited.str());
+        fresh.loadFromStream(reload);
+
+        expect(company.getEmployeeCount() == fresh.getEmployeeCount(), "reconcile roster size");
+        for (auto& emp : fresh.getEmployees()) {
+            Employee* kept = company.findEmployee(emp->getID());
+            expect(kept && kept->getKind() == emp->getKind() &&
+                   kept->getRecordHash() == emp->getRecordHash(),
+                   "reconcile record for " + emp->getID());
+        }
+        for (auto& emp : company.getEmployees()) {
+            expect(fresh.findEmployee(emp->getID()) != nullptr, "reconcile kept removed " + emp->getID());
+        }
+    }
+
+    // Cycle cuts and prefix-sum rollups against walking every node up
+    // to its root
+    void checkOrgChart(int count) {
+        vector<int> parentOf(count, -1);
+        for (int v = 1; v < count; v++) {
+            if (rng() % 10) parentOf[v] = rng() % v;
+        }
+        // A few upward edges that may close cycles
+        for (int v = 0; v < count; v++) {
+            if (rng() % 100 == 0) parentOf[v] = rng() % count;
+        }
+        vector<float> pay(count), rating(count);
+        for (int v = 0; v < count; v++) {
+            pay[v] = rng() % 10000;
+            rating[v] = rng() % 3 ? 0 : 1 + rng() % 5;
+        }
+        OrgChart chart(parentOf);
+        chart.rollup(pay, rating);
+
+        // Every cut must sit on a distinct cycle of the input, and cutting
+        // them must leave no cycle behind
+        vector<char> cycleCut(count, 0); // by lowest node on the cycle
+        for (int v : chart.getCycleCuts()) {
+            int lowest = v, steps = 0;
+            int up = parentOf[v];
+            for (; up >= 0 && up != v && steps <= count; up = parentOf[up], steps++) {
+                lowest = min(lowest, up);
+            }
+            expect(up == v, "org chart cut node " + to_string(v) + " off a cycle");
+            expect(!cycleCut[lowest], "org chart cut one cycle twice");
+            cycleCut[lowest] = 1;
+            parentOf[v] = -1;
+        }
+        vector<int> reports(count, 0);
+        for (int v = 0; v < count; v++) {
+            int steps = 0;
+            for (int up = parentOf[v]; up >= 0 && steps <= count; up = parentOf[up]) steps++;
+            expect(steps <= count, "org chart left a cycle at node " + to_string(v));
+            if (steps > count) return;
+            if (parentOf[v] >= 0) reports[parentOf[v]]++;
+        }
+
+        vector<int> headcount(count, 0), rated(count, 0);
+        vector<double> team(count, 0), ratingSum(count, 0);
+        for (int v = 0; v < count; v++) {
+            if (rating[v] > 0) {
+                rated[v]++;
+                ratingSum[v] += rating[v];
+            }
+            for (int up = parentOf[v]; up >= 0; up = parentOf[up]) {
+                headcount[up]++;
+                team[up] += pay[v];
+                if (rating[v] > 0) {
+                    rated[up]++;
+                    ratingSum[up] += rating[v];
+                }
+            }
+        }
+        for (int v = 0; v < count; v++) {
+            string at = " at node " + to_string(v);
+            expect(chart.directReports(v) == reports[v], "org chart direct reports" + at);
+            double subtreePay = 0;
+            for (const int* node = chart.subtreeBegin(v); node != chart.subtreeEnd(v); node++) {
+                if (*node != v) subtreePay += pay[*node];
+            }
+            expect(close(subtreePay, team[v]), "org chart subtree range" + at);
+            expect(chart.headcount(v) == headcount[v], "org chart headcount" + at);
+            expect(chart.ratedCount(v) == rated[v], "org chart rated count" + at);
+            expect(close(chart.teamPayroll(v), team[v]), "org chart team payroll" + at);
+            expect(close(chart.averageRating(v), rated[v] ? ratingSum[v] / rated[v] : 0),
+                   "org chart average rating" + at);
+        }
+    }
+
+public:
+    SelfCheck(unsigned seed) : rng(seed), checks(0), failures(0) {}
+
+    int run(int count, int rounds) {
+        for (int round = 0; round < rounds; round++) {
+            string text = buildRoster(count);
+            Company company("Reference"), twin("Batched");
+            stringstream first(text), second(text);
+            company.loadFromStream(first);
+            twin.loadFromStream(second);
+
+            readReferenceInputs(text);
+            checkLoads(text, company);
+            checkPay(company);
+            checkTax(company);
+            checkQueries(company);
+            checkMutations(company, twin, 20);
+            checkPay(company);
+            checkReconcile(company, text);
+            checkOrgChart(min(count, 2000));
+        }
+        checkContractPayout();
+        cout << "selfcheck: " << checks << " checks, " << failures << " mismatch(es)\n";
+        return failures == 0 ? 0 : 1;
+    }
+};
+
+#ifdef PAYROLL_FUZZ
+// libFuzzer target for the roster parser, built instead of main:
+//   clang++ -std=c++17 -g -O1 -fsanitize=fuzzer,address -DPAYROLL_FUZZ Payroll.cc
+// Any input must load without crashing, and the eager, lazy and engine
+// paths must agree on whatever it loads.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    string text((const char*)data, size);
+    streambuf* saved = cout.rdbuf(nullptr);
+    {
+        Company eager("Fuzz"), lazy("Fuzz"), strict("Fuzz");
+        stringstream input(text), strictInput(text);
+        eager.loadFromStream(input);
+        lazy.loadLazy(text);
+        strict.loadFromStream(strictInput, true);
+
+        const auto& a = eager.getEmployees();
+        const auto& b = lazy.getEmployees();
+        if (a.size() != b.size() || strict.getEmployeeCount() > eager.getEmployeeCount()) abort();
+
+        const HotColumn& hot = eager.getHotRecords();
+        PayrollPeriodEngine engine(hot, 1);
+        for (size_t e = 0; e < hot.size(); e++) engine.addHours(0, e, hot[e].hours);
+        engine.run();
+        for (size_t i = 0; i < a.size(); i++) {
+            float pay = a[i]->calculatePay();
+            float lazyPay = b[i]->calculatePay();
+            if (a[i]->getID() != b[i]->getID() || a[i]->getAddress() != b[i]->getAddress()) abort();
+            if (memcmp(&pay, &lazyPay, sizeof(float)) != 0) abort();
+            // Contracts are paid by the engine only when they complete
+            if (a[i]->getKind() == KIND_CONTRACT) pay = 0;
+            if (isfinite(pay) && fabs(engine.getYtdGross(i) - pay) > 1e-3f * max(1.0f, fabs(pay))) abort();
+        }
+    }
+    cout.rdbuf(saved);
+    cout.clear();
+    return 0;
+}
+#endif
+
+// ================= MAIN =================
+
+#ifndef PAYROLL_FUZZ
+int main(int argc, char* argv[]) {
+    // Command line modes:
+    //   Payroll [--lazy] [--strict] [roster-file]
+    //   Payroll --generate <count> <output-file>
+    //   Payroll --bench <name|all> [count]
+    //   Payroll --serve <socket> [roster-file] [workers]
+    //   Payroll --loadgen <socket> [connections] [requests]
+    //   Payroll --selfcheck [count] [rounds] [seed]
+    //   Payroll --memory <count|roster-file>
+    //   Payroll --perf-check <baseline.json> [threshold-percent]
+    //   Payroll --perf-record <baseline.json> [count]
+    if (argc > 1 && string(argv[1]) == "--generate") {
+        if (argc < 4) {
+            cout << "Usage: " << argv[0] << " --generate <count> <output-file>\n";
+            return 1;
+        }
+        ofstream out(argv[3]);
+        if (!out.is_open()) {
+            cout << "Error creating file!\n";
+            return 1;
+        }
+        generateRoster(out, atoi(argv[2]), 42);
+        return 0;
+    }
+    if (argc > 1 && (string(argv[1]) == "--serve" || string(argv[1]) == "--loadgen")) {
+#ifdef __linux__
+        if (argc < 3) {
+            cout << "Usage: " << argv[0] << " " << argv[1] << " <socket> ...\n";
+            return 1;
+        }
+        if (string(argv[1]) == "--loadgen") {
+            int connections = argc > 3 ? atoi(argv[3]) : 4;
+            int requests = argc > 4 ? atoi(argv[4]) : 10000;
+            return runLoadGenerator(argv[2], connections, requests);
+        }
+
+        Company company("TechCorp Solutions");
+        string roster = argc > 3 ? argv[3] : "employees.txt";
+        int workers = argc > 4 ? atoi(argv[4]) : max(1u, thread::hardware_concurrency());
+        if (workers < 1) {
+            cout << "Worker count must be at least 1\n";
+            return 1;
+        }
+        if (!company.loadFromFile(roster)) {
+            cout << "Failed to load employees!\n";
+            return 1;
+        }
+        QueryServer server(company, argv[2], workers);
+        if (!server.start()) return 1;
+        server.run();
+        return 0;
+#else
+        cout << "Server mode is only available on Linux.\n";
+        return 1;
+#endif
+    }
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        string name = argc > 2 ? argv[2] : "all";
+        int count = argc > 3 ? atoi(argv[3]) : 100000;
+        return runBenchmark(name, count);
+    }
+    if (argc > 1 && string(argv[1]) == "--memory") {
+        return runMemoryReport(argc > 2 ? argv[2] : "employees.txt");
+    }
+    if (argc > 2 && (string(argv[1]) == "--perf-check" || string(argv[1]) == "--perf-record")) {
+        bool record = string(argv[1]) == "--perf-record";
+        double threshold = !record && argc > 3 ? atof(argv[3]) : 25;
+        int count = record && argc > 3 ? atoi(argv[3]) : 200000;
+        return runPerfBaseline(argv[2], record, threshold, count);
+    }
+    if (argc > 1 && string(argv[1]) == "--selfcheck") {
+        int count = argc > 2 ? atoi(argv[2]) : 5000;
+        int rounds = argc > 3 ? atoi(argv[3]) : 3;
+        unsigned seed = argc > 4 ? strtoul(argv[4], nullptr, 10) : 42;
+        return SelfCheck(seed).run(count, rounds);
+    }
+
+    Company company("TechCorp Solutions");
+
+    cout << "========================================\n";
+    cout << "   EMPLOYEE MANAGEMENT SYSTEM\n";
+    cout << "========================================\n\n";
+
+    int arg = 1;
+    bool lazy = false, strict = false;
+    for (; argc > arg; arg++) {
+        if (string(argv[arg]) == "--lazy") lazy = true;
+        else if (string(argv[arg]) == "--strict") strict = true;
+        else break;
+    }
+    string filename = argc > arg ? argv[arg] : "employees.txt";
+    cout << "Loading employees from '" << filename << "'"
+         << (lazy ? " (lazy)" : "") << (strict ? " (strict)" : "") << "...\n\n";
 
-    if (!company.loadFromFile(filename)) {
+    if (!company.loadFromFile(filename, lazy, strict)) {
         cout << "Failed to load employees!\n";
         return 1;
     }
@@ -894,7 +4487,14 @@ int main() {
         cout << "14. Complete Project (Developer)\n";
         cout << "15. Log Hours (Part-Time)\n";
         cout << "16. Export Report to File\n";
-        cout << "17. Exit\n";
+        cout << "17. Multi-Period Payroll Run\n";
+        cout << "18. Select Tax Policy\n";
+        cout << "19. Reconcile Roster File\n";
+        cout << "20. Bulk Raise by Department/Rating\n";
+        cout << "21. Bulk Bonus from File\n";
+        cout << "22. Load Reporting Lines\n";
+        cout << "23. Org Chart Rollup\n";
+        cout << "24. Exit\n";
         cout << "========================================\n";
         cout << "Enter choice: ";
         cin >> choice;
@@ -916,10 +4516,18 @@ int main() {
             case 14: company.completeProjectForDeveloper(); break;
             case 15: company.logHoursForPartTime(); break;
             case 16: company.exportToFile(); break;
-            case 17: cout << "Exiting system...\n"; break;
+            case 17: company.runMultiPeriodPayroll(); break;
+            case 18: company.selectTaxPolicy(); break;
+            case 19: company.reconcileRosterFile(); break;
+            case 20: company.bulkRaiseByCriteria(); break;
+            case 21: company.bulkBonusFromFile(); break;
+            case 22: company.loadReportingFile(); break;
+            case 23: company.showOrgRollup(); break;
+            case 24: cout << "Exiting system...\n"; break;
             default: cout << "Invalid choice!\n";
         }
-    } while(choice != 17);
+    } while(choice != 24);
 
     return 0;
 }
+#endif